@@ -40,9 +40,9 @@ int Analyser::GenAnalysis::ProcessFiles ( Utilities::DataSet& dataset )
 #pragma omp parallel for reduction(+:sampleTotal)
         for ( int i = 0; i < dataset.fileList.size ( ); i++ )
         {
-            fluid::RealVector in ( 0 );
-            bool success = mAudioLoader.ReadAudioFile ( dataset.fileList[i], in, dataset.analysisSettings.sampleRate );
-            if ( success ) { sampleTotal += in.size ( ); }
+            size_t length = 0;
+            bool success = mAudioLoader.ReadAudioLength ( dataset.fileList[i], dataset.analysisSettings.sampleRate, length );
+            if ( success ) { sampleTotal += length; }
         }
         fileLengthSumTotal = sampleTotal;
     }
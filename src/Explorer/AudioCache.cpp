@@ -0,0 +1,211 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Explorer/AudioCache.h"
+
+#include <flucoma/data/TensorTypes.hpp>
+#include <ofLog.h>
+#include <algorithm>
+#include <chrono>
+
+using namespace Acorex;
+
+Explorer::AudioCache::AudioCache ( )
+    : mSampleRate ( DEFAULT_ANALYSE_SAMPLE_RATE ), mBudgetBytes ( 0 ), mUseClock ( 0 ), mPendingRequests ( 0 ),
+    mHits ( 0 ), mMisses ( 0 ), mLoads ( 0 ), mEvictions ( 0 ), mResidentFiles ( 0 ), mResidentBytes ( 0 ),
+    bRunning ( false )
+{
+}
+
+void Explorer::AudioCache::Initialise ( const Utilities::DataSet& dataset, size_t budgetBytes )
+{
+    Stop ( );
+
+    mFileList = dataset.fileList;
+    mSampleRate = dataset.analysisSettings.sampleRate;
+    mBudgetBytes = budgetBytes;
+
+    for ( size_t i = 0; i < mFileList.size ( ); i++ )
+    {
+        mFiles.push_back ( std::make_unique<CachedFile> ( ) );
+    }
+
+    bRunning = true;
+    mLoaderThread = std::thread ( &AudioCache::LoaderThreadLoop, this );
+}
+
+void Explorer::AudioCache::Stop ( )
+{
+    bRunning = false;
+    if ( mLoaderThread.joinable ( ) ) { mLoaderThread.join ( ); }
+
+    mFiles.clear ( );
+    mFileList.clear ( );
+
+    mUseClock = 0; mPendingRequests = 0;
+    mHits = 0; mMisses = 0; mLoads = 0; mEvictions = 0;
+    mResidentFiles = 0; mResidentBytes = 0;
+}
+
+const float* Explorer::AudioCache::Pin ( size_t fileIndex, bool countAccess )
+{
+    if ( fileIndex >= mFiles.size ( ) ) { return nullptr; }
+
+    CachedFile& file = *mFiles[fileIndex];
+
+    // publish the pin before looking at the state, the loader does the reverse when evicting
+    file.pins.fetch_add ( 1, std::memory_order_seq_cst );
+    if ( file.state.load ( std::memory_order_seq_cst ) == RESIDENT )
+    {
+        file.lastUsed.store ( mUseClock.fetch_add ( 1, std::memory_order_relaxed ), std::memory_order_relaxed );
+        if ( countAccess ) { mHits.fetch_add ( 1, std::memory_order_relaxed ); }
+        return file.samples.data ( );
+    }
+
+    file.pins.fetch_sub ( 1, std::memory_order_seq_cst );
+    if ( countAccess ) { mMisses.fetch_add ( 1, std::memory_order_relaxed ); }
+    RequestLoad ( fileIndex );
+
+    return nullptr;
+}
+
+void Explorer::AudioCache::Unpin ( size_t fileIndex )
+{
+    if ( fileIndex >= mFiles.size ( ) ) { return; }
+
+    mFiles[fileIndex]->lastUsed.store ( mUseClock.fetch_add ( 1, std::memory_order_relaxed ), std::memory_order_relaxed );
+    mFiles[fileIndex]->pins.fetch_sub ( 1, std::memory_order_seq_cst );
+}
+
+bool Explorer::AudioCache::IsResident ( size_t fileIndex ) const
+{
+    if ( fileIndex >= mFiles.size ( ) ) { return false; }
+
+    return mFiles[fileIndex]->state.load ( std::memory_order_acquire ) == RESIDENT;
+}
+
+void Explorer::AudioCache::RequestLoad ( size_t fileIndex, bool countMiss )
+{
+    if ( fileIndex >= mFiles.size ( ) ) { return; }
+    if ( countMiss ) { mMisses.fetch_add ( 1, std::memory_order_relaxed ); }
+
+    CachedFile& file = *mFiles[fileIndex];
+    if ( file.failed.load ( std::memory_order_relaxed ) ) { return; }
+
+    if ( !file.requested.exchange ( true, std::memory_order_acq_rel ) )
+    {
+        mPendingRequests.fetch_add ( 1, std::memory_order_release );
+    }
+}
+
+Explorer::AudioCache::Stats Explorer::AudioCache::GetStats ( ) const
+{
+    Stats stats;
+    stats.hits = mHits.load ( std::memory_order_relaxed );
+    stats.misses = mMisses.load ( std::memory_order_relaxed );
+    stats.loads = mLoads.load ( std::memory_order_relaxed );
+    stats.evictions = mEvictions.load ( std::memory_order_relaxed );
+    stats.residentFiles = mResidentFiles.load ( std::memory_order_relaxed );
+    stats.residentBytes = mResidentBytes.load ( std::memory_order_relaxed );
+    stats.budgetBytes = mBudgetBytes;
+    return stats;
+}
+
+void Explorer::AudioCache::LoaderThreadLoop ( )
+{
+    while ( bRunning )
+    {
+        if ( mPendingRequests.load ( std::memory_order_acquire ) == 0 )
+        {
+            std::this_thread::sleep_for ( std::chrono::milliseconds ( 2 ) );
+            continue;
+        }
+
+        for ( size_t fileIndex = 0; fileIndex < mFiles.size ( ) && bRunning; fileIndex++ )
+        {
+            if ( !mFiles[fileIndex]->requested.load ( std::memory_order_acquire ) ) { continue; }
+
+            mFiles[fileIndex]->requested.store ( false, std::memory_order_release );
+            mPendingRequests.fetch_sub ( 1, std::memory_order_acq_rel );
+
+            if ( mFiles[fileIndex]->state.load ( std::memory_order_acquire ) == EVICTED ) { LoadFile ( fileIndex ); }
+        }
+    }
+}
+
+void Explorer::AudioCache::LoadFile ( size_t fileIndex )
+{
+    CachedFile& file = *mFiles[fileIndex];
+
+    std::vector<float> fileData;
+    if ( !mAudioLoader.ReadAudioFile ( mFileList[fileIndex], fileData, mSampleRate ) )
+    {
+        ofLogError ( "AudioCache" ) << "Failed to load audio file: " << mFileList[fileIndex];
+        file.failed = true;
+        return;
+    }
+
+    size_t bytes = fileData.size ( ) * sizeof ( float );
+    EvictToFit ( bytes );
+
+    file.samples.swap ( fileData );
+    file.lastUsed.store ( mUseClock.fetch_add ( 1, std::memory_order_relaxed ), std::memory_order_relaxed );
+    file.state.store ( RESIDENT, std::memory_order_seq_cst );
+
+    mResidentFiles.fetch_add ( 1, std::memory_order_relaxed );
+    mResidentBytes.fetch_add ( bytes, std::memory_order_relaxed );
+    mLoads.fetch_add ( 1, std::memory_order_relaxed );
+}
+
+void Explorer::AudioCache::EvictToFit ( size_t incomingBytes )
+{
+    if ( mResidentBytes + incomingBytes <= mBudgetBytes ) { return; }
+
+    std::vector<std::pair<uint64_t, size_t>> candidates; // [lastUsed, fileIndex]
+    for ( size_t fileIndex = 0; fileIndex < mFiles.size ( ); fileIndex++ )
+    {
+        if ( mFiles[fileIndex]->state.load ( std::memory_order_relaxed ) != RESIDENT ) { continue; }
+        candidates.push_back ( { mFiles[fileIndex]->lastUsed.load ( std::memory_order_relaxed ), fileIndex } );
+    }
+    std::sort ( candidates.begin ( ), candidates.end ( ) );
+
+    for ( const auto& candidate : candidates )
+    {
+        if ( mResidentBytes + incomingBytes <= mBudgetBytes ) { return; }
+
+        CachedFile& file = *mFiles[candidate.second];
+
+        // publish the eviction before looking at the pins, a pin that got in first keeps the file
+        file.state.store ( EVICTING, std::memory_order_seq_cst );
+        if ( file.pins.load ( std::memory_order_seq_cst ) > 0 )
+        {
+            file.state.store ( RESIDENT, std::memory_order_seq_cst );
+            continue;
+        }
+
+        size_t bytes = file.samples.size ( ) * sizeof ( float );
+        std::vector<float> ( ).swap ( file.samples );
+        file.state.store ( EVICTED, std::memory_order_release );
+
+        mResidentFiles.fetch_sub ( 1, std::memory_order_relaxed );
+        mResidentBytes.fetch_sub ( bytes, std::memory_order_relaxed );
+        mEvictions.fetch_add ( 1, std::memory_order_relaxed );
+    }
+
+    // everything left is pinned by a playhead, go over budget rather than refuse the file
+    ofLogVerbose ( "AudioCache" ) << "Audio cache over budget, all resident files are in use";
+}
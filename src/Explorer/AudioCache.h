@@ -0,0 +1,107 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Utilities/Data.h"
+#include "Utilities/AudioFileLoader.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+namespace Acorex {
+namespace Explorer {
+
+// keeps decoded corpus files resident on demand, evicting the least recently used once over a byte budget
+// files are requested from any thread without blocking and decoded by a single loader thread
+// a pinned file is never evicted: pinning and eviction each publish their intent before checking the other side,
+// so either the pin sees the file leaving, or the loader sees the pin and keeps the file
+class AudioCache {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t loads = 0;
+        uint64_t evictions = 0;
+        size_t residentFiles = 0;
+        size_t residentBytes = 0;
+        size_t budgetBytes = 0;
+    };
+
+    AudioCache ( );
+    ~AudioCache ( ) { Stop ( ); }
+
+    void Initialise ( const Utilities::DataSet& dataset, size_t budgetBytes );
+    void Stop ( );
+
+    bool IsRunning ( ) const { return bRunning; }
+
+    // safe from any thread, never blocks --------
+
+    const float* Pin ( size_t fileIndex, bool countAccess ); // nullptr (and a load request) if not resident, successful pins must be unpinned
+    void Unpin ( size_t fileIndex );
+    bool IsResident ( size_t fileIndex ) const;
+    void RequestLoad ( size_t fileIndex, bool countMiss = false );
+
+    Stats GetStats ( ) const;
+
+private:
+    enum FileState : int {
+        EVICTED = 0,
+        RESIDENT = 1,
+        EVICTING = 2
+    };
+
+    struct CachedFile {
+        std::atomic<int> state { EVICTED };
+        std::atomic<int> pins { 0 };
+        std::atomic<bool> requested { false };
+        std::atomic<bool> failed { false };
+        std::atomic<uint64_t> lastUsed { 0 };
+        std::vector<float> samples; // only touched by the loader thread while not resident
+    };
+
+    void LoaderThreadLoop ( );
+    void LoadFile ( size_t fileIndex );
+    void EvictToFit ( size_t incomingBytes );
+
+    std::vector<std::unique_ptr<CachedFile>> mFiles;
+    std::vector<std::string> mFileList;
+    double mSampleRate;
+    size_t mBudgetBytes;
+
+    std::atomic<uint64_t> mUseClock;
+    std::atomic<int> mPendingRequests;
+
+    std::atomic<uint64_t> mHits;
+    std::atomic<uint64_t> mMisses;
+    std::atomic<uint64_t> mLoads;
+    std::atomic<uint64_t> mEvictions;
+    std::atomic<size_t> mResidentFiles;
+    std::atomic<size_t> mResidentBytes;
+
+    Utilities::AudioFileLoader mAudioLoader;
+
+    std::thread mLoaderThread;
+    std::atomic<bool> bRunning;
+};
+
+} // namespace Explorer
+} // namespace Acorex
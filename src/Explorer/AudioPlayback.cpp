@@ -15,12 +15,18 @@ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 */
 
 #include "Explorer/AudioPlayback.h"
+#include "Utilities/MixKernels.h"
 
 #include "ofLog.h"
 #include <random>
+#include <algorithm>
+#include <type_traits>
+#include <thread>
+#include <chrono>
 
 using namespace Acorex;
 
+
 // TODO - use mSoundStream.stop ( ) for killing the stream
 // might still need flags depending on when exactly stream is killed (audioOut should be allowed to finish processing)
 // but should simplify things
@@ -30,17 +36,26 @@ Explorer::AudioPlayback::AudioPlayback ( )
     bRestartingAudioFlag ( false ), bRestartingAudioFlagConfirmed ( false ),
     bMissingOutputFlag ( false ), bMissingOutputFlagConfirmed ( false ),
     bUserPauseFlag ( false ),
-    mActivePlayheads ( 0 ), playheadCounter ( 0 ),
+    mActivePlayheads ( 0 ), playheadCounter ( 0 ), mSampleTime ( 0 ), mVolume ( 0.5 ), mVolumeChangeCount ( 0 ),
+    mMixCapacityFrames ( 0 ), mResampledFrames ( 0 ), bOffline ( false ),
     mLoopPlayheads ( false ),
     mJumpSameFileAllowed ( false ), mJumpSameFileMinTimeDiff ( 2 ),
     mCrossoverJumpChanceX1000 ( 50 ), mCrossfadeSampleLength ( 256 ), mMaxJumpDistanceSpaceX1000 ( 50 ), mMaxJumpTargets ( 5 ),
-    mVolumeX1000 ( 500 ), mDynamicPanEnabled ( false ), mDynamicPanDimensionIndex ( 0 ), mPanningStrengthX1000 ( 1000 )
+    mDynamicPanEnabled ( false ), mDynamicPanDimensionIndex ( 0 ), mPanningStrengthX1000 ( 1000 )
 {
+    ResetTelemetry ( );
+
     mRandomGen = std::mt19937 ( std::random_device ( ) () );
+
+    mCommands.Reserve ( DEFAULT_PLAYHEAD_COMMAND_QUEUE_SIZE );
+
+    mPlayheads.reserve ( DEFAULT_MAX_PLAYHEADS );
 }
 
 bool Explorer::AudioPlayback::StartRestartAudio ( size_t sampleRate, size_t bufferSize, ofSoundDevice outDevice )
 {
+    size_t deviceSampleRate = ChooseDeviceSampleRate ( sampleRate, outDevice );
+
     // TODO - apply fade out here if stream already started and active playheads exist ?
     {
         std::lock_guard<std::mutex> lock ( mRestartingAudioMutex );
@@ -61,7 +76,7 @@ bool Explorer::AudioPlayback::StartRestartAudio ( size_t sampleRate, size_t buff
     {
         settings.numInputChannels = 0;
         settings.numOutputChannels = 2;
-        settings.sampleRate = sampleRate;
+        settings.sampleRate = deviceSampleRate;
         settings.bufferSize = bufferSize;
         settings.numBuffers = 4;
         settings.setOutListener ( this );
@@ -71,6 +86,9 @@ bool Explorer::AudioPlayback::StartRestartAudio ( size_t sampleRate, size_t buff
     {
         std::lock_guard<std::mutex> audioOutLock ( mKillAudioOnlyAudioThreadBlockingMutex );
         mSoundStream.close ( );
+
+        AllocateVoices ( sampleRate, bufferSize, deviceSampleRate );
+        bOffline = false;
     }
     
     bool success = false;
@@ -97,9 +115,136 @@ bool Explorer::AudioPlayback::StartRestartAudio ( size_t sampleRate, size_t buff
         return false;
     }
 
+    if ( deviceSampleRate != sampleRate )
+    {
+        ofLogNotice ( "AudioPlayback" ) << "Device \"" << outDevice.name << "\" running at " << deviceSampleRate << "Hz, converting from the corpus rate of " << sampleRate << "Hz";
+    }
+
+    return true;
+}
+
+bool Explorer::AudioPlayback::StartOffline ( size_t sampleRate, size_t bufferSize )
+{
+    std::lock_guard<std::mutex> killAudioLock ( mKillAudioOnlyAudioThreadBlockingMutex );
+
+    mSoundStream.close ( );
+    AllocateVoices ( sampleRate, bufferSize, sampleRate );
+    bOffline = true;
+
+    {
+        std::lock_guard<std::mutex> lock ( mMissingOutputMutex );
+        bMissingOutputFlag = false; bMissingOutputFlagConfirmed = false;
+    }
+    {
+        std::lock_guard<std::mutex> lock ( mRestartingAudioMutex );
+        bRestartingAudioFlag = false; bRestartingAudioFlagConfirmed = false;
+    }
+
+    // nothing else will call audioOut, but playheads and commands behave as if a stream were running
+    bStreamStarted = true;
+
+    return true;
+}
+
+void Explorer::AudioPlayback::RenderOffline ( ofSoundBuffer& outBuffer )
+{
+    mJumpPlanner.PlanNow ( );
+
+    // waiting here is what a live stream can't do, so a slow disk changes how long the render takes rather than how it sounds
+    size_t startTime = ofGetElapsedTimeMillis ( );
+    while ( !OfflineSourcesReady ( outBuffer.getNumFrames ( ) ) )
+    {
+        if ( ofGetElapsedTimeMillis ( ) - startTime > DEFAULT_OFFLINE_RENDER_SOURCE_TIMEOUT_MS )
+        {
+            ofLogWarning ( "AudioPlayback" ) << "Gave up waiting for playhead audio while rendering offline, some playheads will be silent for this buffer";
+            break;
+        }
+        std::this_thread::sleep_for ( std::chrono::milliseconds ( 1 ) );
+    }
+
+    audioOut ( outBuffer );
+}
+
+bool Explorer::AudioPlayback::OfflineSourcesReady ( size_t frames )
+{
+    AudioCache* cache = mRawView->GetAudioCache ( );
+
+    for ( const auto& playhead : mPlayheads )
+    {
+        if ( cache != nullptr && playhead.cachedSamples == nullptr && !cache->IsResident ( playhead.fileIndex ) ) { return false; }
+
+        if ( playhead.streamSlot < 0 ) { continue; }
+
+        if ( mStreamer.Available ( playhead.streamSlot ) < frames ) { return false; }
+        if ( ( playhead.crossfading || playhead.jumpPending || playhead.loopPrefetched ) && mStreamer.Available ( playhead.jumpStreamSlot ) < frames ) { return false; }
+    }
+
     return true;
 }
 
+size_t Explorer::AudioPlayback::ChooseDeviceSampleRate ( size_t corpusSampleRate, const ofSoundDevice& outDevice )
+{
+    if ( DEFAULT_AUDIO_DEVICE_SAMPLE_RATE > 0 ) { return DEFAULT_AUDIO_DEVICE_SAMPLE_RATE; }
+
+    // a device that doesn't list its rates is trusted with the corpus rate, as before
+    const std::vector<unsigned int>& rates = outDevice.sampleRates;
+    if ( rates.empty ( ) || std::find ( rates.begin ( ), rates.end ( ), corpusSampleRate ) != rates.end ( ) ) { return corpusSampleRate; }
+
+    // otherwise the lowest rate above the corpus rate, so nothing in the corpus is lost, or failing that the highest there is
+    size_t lowestAbove = 0;
+    size_t highest = 0;
+    for ( unsigned int rate : rates )
+    {
+        if ( rate > corpusSampleRate && ( lowestAbove == 0 || rate < lowestAbove ) ) { lowestAbove = rate; }
+        highest = std::max ( highest, (size_t)rate );
+    }
+    return lowestAbove > 0 ? lowestAbove : highest;
+}
+
+void Explorer::AudioPlayback::AllocateVoices ( size_t sampleRate, size_t bufferSize, size_t deviceSampleRate )
+{
+    mOutputResampler[0].Initialise ( (double)sampleRate, (double)deviceSampleRate );
+    mOutputResampler[1].Initialise ( (double)sampleRate, (double)deviceSampleRate );
+
+    // converting, playheads render however many corpus rate frames each device buffer needs, a frame or two either side of the ratio
+    if ( !mOutputResampler[0].IsPassthrough ( ) )
+    {
+        mMixCapacityFrames = (size_t)std::ceil ( (double)bufferSize * mOutputResampler[0].GetStep ( ) ) + 2;
+        mMixBuffer.setSampleRate ( sampleRate );
+        mMixBuffer.allocate ( mMixCapacityFrames, 2 );
+
+        for ( int channel = 0; channel < 2; channel++ )
+        {
+            mOutputResampler[channel].Reserve ( mMixCapacityFrames );
+            mResampleIn[channel].assign ( mMixCapacityFrames, 0.0f );
+            mResampleOut[channel].assign ( mOutputResampler[channel].GetMaxOutputFrames ( mMixCapacityFrames ), 0.0f );
+        }
+        mResampled.assign ( ( bufferSize + mResampleOut[0].size ( ) ) * 2, 0.0f );
+
+        bufferSize = std::max ( bufferSize, mMixCapacityFrames );
+    }
+    mResampledFrames = 0;
+
+    if ( mRenderPool.GetWorkerCount ( ) != DEFAULT_VOICE_RENDER_WORKERS ) { mRenderPool.Start ( DEFAULT_VOICE_RENDER_WORKERS ); }
+
+    mVoiceScratch.resize ( mRenderPool.GetWorkerCount ( ) + 1 );
+    for ( auto& voiceScratch : mVoiceScratch )
+    {
+        voiceScratch.stream[0].assign ( bufferSize, 0.0f );
+        voiceScratch.stream[1].assign ( bufferSize, 0.0f );
+    }
+
+    mVoiceBuffers.resize ( DEFAULT_MAX_PLAYHEADS );
+    for ( auto& voiceBuffer : mVoiceBuffers )
+    {
+        voiceBuffer.setSampleRate ( sampleRate );
+        voiceBuffer.allocate ( bufferSize, 2 );
+    }
+
+    ResetTelemetry ( );
+    mGovernor.Reset ( );
+}
+
 void Explorer::AudioPlayback::ClearAndKillAudio ( )
 {
     std::lock_guard<std::mutex> killAudioLock ( mKillAudioOnlyAudioThreadBlockingMutex );
@@ -119,30 +264,26 @@ void Explorer::AudioPlayback::ClearAndKillAudio ( )
 
     bUserPauseFlag = false;
 
+    for ( auto& playhead : mPlayheads ) { ReleasePlayheadSources ( playhead ); }
     mPlayheads.clear ( );
     mActivePlayheads = 0;
 
+    mStreamer.Stop ( );
+    mJumpPlanner.Stop ( );
+    mRenderPool.Stop ( );
+
     {
-        std::lock_guard<std::mutex> newPlayheadLock ( mNewPlayheadMutex );
-        while ( !mNewPlayheads.empty ( ) ) { mNewPlayheads.pop ( ); }
-        while ( !mPlayheadsToKill.empty ( ) ) { mPlayheadsToKill.pop ( ); }
+        // the audio thread can't be consuming while the kill lock is held, so this thread stands in for it
+        std::lock_guard<std::mutex> commandSendLock ( mCommandSendMutex );
+        PlayheadCommand command;
+        while ( mCommands.Pop ( command ) ) { }
         playheadCounter = 0;
+        mSampleTime = 0;
     }
 
-    {
-        std::lock_guard<std::mutex> visualPlayheadUpdateLock ( mVisualPlayheadUpdateMutex );
-        mVisualPlayheads.clear ( );
-    }
+    PublishPlayheadStates ( ); // none left, the audio thread isn't running so this thread publishes in its place
 
-    {
-        std::lock_guard<std::mutex> dimensionBoundsLock ( mDimensionBoundsMutex );
-        mDimensionBounds = Utilities::DimensionBoundsData ( );
-    }
-
-    {
-        std::lock_guard<std::mutex> timeCorpusLock ( mCorpusMeshMutex );
-        mCorpusMesh.clear ( );
-    }
+    mDimensionBounds.Publish ( std::make_unique<Utilities::DimensionBoundsData> ( ) );
 
     mLoopPlayheads = false;
     mJumpSameFileAllowed = false;
@@ -151,7 +292,8 @@ void Explorer::AudioPlayback::ClearAndKillAudio ( )
     mCrossfadeSampleLength = 256;
     mMaxJumpDistanceSpaceX1000 = 50;
     mMaxJumpTargets = 5;
-    mVolumeX1000 = 500;
+    mVolume = 0.5;
+    mVolumeChangeCount = 0;
     mDynamicPanEnabled = false;
     mDynamicPanDimensionIndex = 0;
     mPanningStrengthX1000 = 1000;
@@ -159,21 +301,33 @@ void Explorer::AudioPlayback::ClearAndKillAudio ( )
     return;
 }
 
+void Explorer::AudioPlayback::InitialiseStorage ( bool offline )
+{
+    if ( bStreamStarted )
+    {
+        ofLogError ( "AudioPlayback" ) << "Attempted to initialise audio storage while audio stream is active, this should never happen, as it could hang the audio thread.";
+    }
+
+    mStreamer.Stop ( );
+
+    if ( IsStreamed ( ) )
+    {
+        mStreamer.Initialise ( *mRawView->GetDataset ( ), DEFAULT_STREAM_MAX_PLAYHEADS );
+    }
+
+    mJumpPlanner.Initialise ( mPointPicker, mRawView, DEFAULT_MAX_PLAYHEADS, !offline ); // a slot for every voice in the pool, so every playhead can jump
+}
+
 void Explorer::AudioPlayback::audioOut ( ofSoundBuffer& outBuffer )
 {
     // TODO - change this and other lock_guard/try_lock instances to unique_lock with something like:
-    //              std::unique_lock<std::mutex> lock ( mNewPlayheadMutex, std::try_to_lock );
+    //              std::unique_lock<std::mutex> lock ( mRestartingAudioMutex, std::try_to_lock );
     //              if ( lock.owns_lock ( ) )
     if ( mKillAudioOnlyAudioThreadBlockingMutex.try_lock ( ) )
     {
         std::lock_guard<std::mutex> lock ( mKillAudioOnlyAudioThreadBlockingMutex, std::adopt_lock );
 
-        // zero the output buffer
-        for ( size_t sampleIndex = 0; sampleIndex < outBuffer.getNumFrames ( ); sampleIndex++ )
-        {
-            outBuffer.getSample ( sampleIndex, 0 ) = 0.0;
-            outBuffer.getSample ( sampleIndex, 1 ) = 0.0;
-        }
+        std::chrono::steady_clock::time_point callbackStart = std::chrono::steady_clock::now ( );
 
         // check flags that might block audio processing
         bool audioProcessingBlocked = false;
@@ -200,235 +354,414 @@ void Explorer::AudioPlayback::audioOut ( ofSoundBuffer& outBuffer )
             //if ( audioProcessingBlocked ) { return; }
         }
 
-        std::vector<size_t> playheadsToKillThisBuffer;
+        Utilities::NoAllocationScope noAllocationScope; // asserts on any allocation from here on, in debug builds with the check enabled
+
+        // playheads run at the corpus rate, a device at any other rate is fed through the output resamplers
+        if ( mOutputResampler[0].IsPassthrough ( ) ) { RenderMix ( outBuffer, audioProcessingBlocked ); }
+        else { RenderResampled ( outBuffer, audioProcessingBlocked ); }
+
+        // get playhead post-processing location info for main thread
+        if ( mGovernor.VisualUpdateDue ( ) ) { PublishPlayheadStates ( ); }
 
-        // get playhead user changes from main thread, kill playheads here if audio processing is blocked
-        if ( mNewPlayheadMutex.try_lock ( ) )
+        float loadPercent = RecordCallbackTime ( callbackStart, outBuffer.getNumFrames ( ), outBuffer.getSampleRate ( ) );
+        if ( !bOffline && outBuffer.getSampleRate ( ) > 0 )
         {
-            std::lock_guard<std::mutex> lock ( mNewPlayheadMutex, std::adopt_lock );
+            ShedVoices ( mGovernor.Update ( loadPercent, (double)outBuffer.getNumFrames ( ) / (double)outBuffer.getSampleRate ( ) ) );
+        }
+    }
+}
 
-            while ( !mNewPlayheads.empty ( ) )
-            {
-                mPlayheads.push_back ( mNewPlayheads.front ( ) );
-                mNewPlayheads.pop ( );
-            }
+void Explorer::AudioPlayback::RenderMix ( ofSoundBuffer& mixBuffer, bool audioProcessingBlocked )
+{
+    size_t frames = mixBuffer.getNumFrames ( );
+
+    // zero the output buffer
+    std::fill ( mixBuffer.getBuffer ( ).begin ( ), mixBuffer.getBuffer ( ).end ( ), 0.0f );
+
+    bool streamed = IsStreamed ( );
+    AudioCache* cache = mRawView->GetAudioCache ( );
+
+    JumpPlanner::Rules jumpRules = GetJumpRules ( );
+
+    // get playhead user changes from control threads, kill playheads here if audio processing is blocked
+    ApplyCommands ( frames, audioProcessingBlocked, streamed, cache, jumpRules );
+
+    // audio processing
+    if ( !audioProcessingBlocked )
+    {
+        VoiceRenderContext context;
+        context.streamed = streamed;
+        context.compact = mRawView->GetAudioData ( )->sampleFormat == Utilities::AudioSampleFormat::INT16;
+        context.cache = cache;
+        context.loopPlayheads = mLoopPlayheads;
+        context.crossfadeSampleLength = jumpRules.remainingSamplesRequired;
+        context.jumpRules = jumpRules;
+        context.crossoverJumpChanceX1000 = mGovernor.CrossoverJumpChanceX1000 ( mCrossoverJumpChanceX1000 );
+
+        double panningStrength = (double)mPanningStrengthX1000 / 1000.0;
+        int panDimensionIndex = mDynamicPanDimensionIndex;
+        auto dimensionBounds = mDimensionBounds.Read ( );
+        if ( mDynamicPanEnabled && panningStrength > 0.0 && dimensionBounds && panDimensionIndex >= 0 && (size_t)panDimensionIndex < dimensionBounds->min.size ( ) )
+        {
+            context.panningStrength = (float)panningStrength;
+            context.panDimensionIndex = panDimensionIndex;
+            context.panMin = dimensionBounds->min[panDimensionIndex];
+            context.panMax = dimensionBounds->max[panDimensionIndex];
+        }
+
+        // each playhead only touches its own state and voice buffer, so with enough of them they are shared out to the render pool
+        auto renderVoice = [this, &context, frames] ( size_t playheadIndex, size_t workerIndex )
+        {
+            mVoiceBuffers[playheadIndex].resize ( frames * 2 ); // within what was allocated for the stream
+            RenderVoice ( mPlayheads[playheadIndex], mVoiceBuffers[playheadIndex], context, mVoiceScratch[workerIndex] );
+        };
+
+        if ( mPlayheads.size ( ) >= DEFAULT_VOICE_RENDER_MIN_PARALLEL_PLAYHEADS ) { mRenderPool.Run ( mPlayheads.size ( ), renderVoice ); }
+        else { for ( size_t playheadIndex = 0; playheadIndex < mPlayheads.size ( ); playheadIndex++ ) { renderVoice ( playheadIndex, 0 ); } }
+
+        // summed in playhead order whichever thread rendered them, so the mix is the same however they were shared out
+        for ( size_t playheadIndex = 0; playheadIndex < mPlayheads.size ( ); playheadIndex++ )
+        {
+            Utilities::MixKernels::Accumulate ( mVoiceBuffers[playheadIndex].getBuffer ( ).data ( ), frames * 2, mixBuffer.getBuffer ( ).data ( ) );
+
+            if ( mPlayheads[playheadIndex].killed ) { ReleasePlayheadSources ( mPlayheads[playheadIndex] ); }
+        }
+
+        GatherVoiceTelemetry ( );
+
+        mPlayheads.erase ( std::remove_if ( mPlayheads.begin ( ), mPlayheads.end ( ), [] ( const Utilities::AudioPlayhead& playhead ) { return playhead.killed; } ), mPlayheads.end ( ) );
+    }
+
+    ApplyVolume ( mixBuffer );
+
+    mActivePlayheads = mPlayheads.size ( );
+    mSampleTime += frames;
+}
+
+void Explorer::AudioPlayback::RenderResampled ( ofSoundBuffer& outBuffer, bool audioProcessingBlocked )
+{
+    size_t outFrames = outBuffer.getNumFrames ( );
+
+    // render at the corpus rate until enough has come out of the resamplers, usually once a callback
+    // the mix is sized for what is still missing, the filter's fractional position makes that one frame more or less now and then
+    while ( mResampledFrames < outFrames )
+    {
+        size_t sourceFrames = (size_t)std::ceil ( (double)( outFrames - mResampledFrames ) * mOutputResampler[0].GetStep ( ) ) + 1;
+        sourceFrames = std::min ( sourceFrames, mMixCapacityFrames );
+
+        mMixBuffer.resize ( sourceFrames * 2 );
+        RenderMix ( mMixBuffer, audioProcessingBlocked );
+
+        const float* mix = mMixBuffer.getBuffer ( ).data ( );
+        for ( size_t frame = 0; frame < sourceFrames; frame++ )
+        {
+            mResampleIn[0][frame] = mix[frame * 2];
+            mResampleIn[1][frame] = mix[frame * 2 + 1];
+        }
+
+        size_t produced = mOutputResampler[0].ProcessChunk ( mResampleIn[0].data ( ), sourceFrames, mResampleOut[0].data ( ) );
+        mOutputResampler[1].ProcessChunk ( mResampleIn[1].data ( ), sourceFrames, mResampleOut[1].data ( ) ); // same position and step, so the same count
+
+        float* resampled = mResampled.data ( ) + mResampledFrames * 2;
+        for ( size_t frame = 0; frame < produced; frame++ )
+        {
+            resampled[frame * 2] = mResampleOut[0][frame];
+            resampled[frame * 2 + 1] = mResampleOut[1][frame];
+        }
+        mResampledFrames += produced;
+    }
+
+    std::copy ( mResampled.begin ( ), mResampled.begin ( ) + outFrames * 2, outBuffer.getBuffer ( ).begin ( ) );
+    std::copy ( mResampled.begin ( ) + outFrames * 2, mResampled.begin ( ) + mResampledFrames * 2, mResampled.begin ( ) );
+    mResampledFrames -= outFrames;
+}
+
+void Explorer::AudioPlayback::RenderVoice ( Utilities::AudioPlayhead& playhead, ofSoundBuffer& playheadBuffer, const VoiceRenderContext& context, VoiceScratch& scratch )
+{
+    // already this size since the stream started, so nothing is allocated here
+    std::fill ( playheadBuffer.getBuffer ( ).begin ( ), playheadBuffer.getBuffer ( ).end ( ), 0.0f );
+
+    // a file that isn't cached yet holds the playhead silent until the loader thread has it
+    if ( context.cache != nullptr && playhead.cachedSamples == nullptr )
+    {
+        playhead.cachedSamples = context.cache->Pin ( playhead.fileIndex, false );
+    }
 
-            while ( !mPlayheadsToKill.empty ( ) )
+    size_t playheadBufferPosition = std::min ( playhead.bufferStartOffset, (size_t)playheadBuffer.getNumFrames ( ) );
+    playhead.bufferStartOffset = 0;
+    // processing loop
+    while ( context.cache == nullptr || playhead.cachedSamples != nullptr )
+    {
+        // if EOF: loop/kill
+        if ( !TriggerPointsRemain ( playhead ) )
+        {
+            if ( context.loopPlayheads )
             {
-                if ( audioProcessingBlocked )
+                playhead.sampleIndex = 0;
+
+                if ( context.streamed && playhead.loopPrefetched )
                 {
-                    for ( size_t i = 0; i < mPlayheads.size ( ); i++ )
-                    {
-                        if ( mPlayheads[i].playheadID == mPlayheadsToKill.front ( ) )
-                        {
-                            mPlayheads.erase ( mPlayheads.begin ( ) + i );
-                            break;
-                        }
-                    }
+                    std::swap ( playhead.streamSlot, playhead.jumpStreamSlot );
+                    mStreamer.Cancel ( playhead.jumpStreamSlot );
+                    playhead.loopPrefetched = false;
                 }
-                else
+                else if ( context.streamed )
                 {
-                    playheadsToKillThisBuffer.push_back ( mPlayheadsToKill.front ( ) );
+                    mStreamer.Request ( playhead.streamSlot, playhead.fileIndex, 0 );
                 }
-
-                mPlayheadsToKill.pop ( );
+            }
+            else
+            {
+                if ( !playhead.killRequested ) { playhead.killRequested = true; playhead.killOffset = 0; scratch.voicesEnded++; }
+                break;
             }
         }
 
-        // audio processing
-        if ( !audioProcessingBlocked )
+        // crossfade jump
+        if ( playhead.crossfading )
         {
-            double volume = (double)mVolumeX1000 / 1000.0;
-            double panningStrength = (double)mPanningStrengthX1000 / 1000.0;
+            if ( context.compact ) { CrossfadeAudioSegment<int16_t> ( &playheadBuffer, &playheadBufferPosition, &playhead, false, context, scratch ); }
+            else { CrossfadeAudioSegment<float> ( &playheadBuffer, &playheadBufferPosition, &playhead, false, context, scratch ); }
 
-            // playhead loop
-            for ( size_t playheadIndex = 0; playheadIndex < mPlayheads.size ( ); playheadIndex++ )
-            {
-                Utilities::AudioPlayhead* currentPlayhead = &mPlayheads[playheadIndex]; // TODO - why is this not used - replace all instances of mPlayheads[playheadIndex] with currentPlayhead?
+            if ( playhead.crossfading ) { break; }
+        }
 
-                ofSoundBuffer playheadBuffer;
-                playheadBuffer.setSampleRate ( mSoundStream.getSampleRate ( ) );
-                playheadBuffer.allocate ( outBuffer.getNumFrames ( ), 2 );
+        // exit loop - no more space in outbuffer, no more triggers hit
+        if ( (playheadBuffer.getNumFrames ( ) - playheadBufferPosition) < (NextTriggerPoint ( playhead ) - playhead.sampleIndex) )
+        {
+            if ( context.compact ) { FillAudioSegment<int16_t> ( &playheadBuffer, &playheadBufferPosition, &playhead, true, context, scratch ); }
+            else { FillAudioSegment<float> ( &playheadBuffer, &playheadBufferPosition, &playhead, true, context, scratch ); }
+            break;
+        }
 
-                for ( size_t i = 0; i < playheadBuffer.getNumFrames ( ); i++ )
-                {
-                    playheadBuffer.getSample ( i, 0 ) = 0.0;
-                    playheadBuffer.getSample ( i, 1 ) = 0.0;
-                }
+        // fill audio up to the next trigger, already established that there is enough space in outBuffer
+        // streamed audio that hasn't arrived yet stalls the playhead for the rest of this buffer
+        bool segmentComplete = context.compact  ? FillAudioSegment<int16_t> ( &playheadBuffer, &playheadBufferPosition, &playhead, false, context, scratch )
+                                                : FillAudioSegment<float> ( &playheadBuffer, &playheadBufferPosition, &playhead, false, context, scratch );
+        if ( !segmentComplete ) { break; }
 
-                size_t playheadBufferPosition = 0;
-                // processing loop
-                while ( true )
-                {
-                    // remove trigger points that have been hit
-                    while ( mPlayheads[playheadIndex].triggerSamplePoints.size ( ) > 0 && mPlayheads[playheadIndex].sampleIndex >= mPlayheads[playheadIndex].triggerSamplePoints.front ( ) )
-                    {
-                        mPlayheads[playheadIndex].triggerSamplePoints.pop ( );
-                    }
-
-                    // if EOF: loop/kill
-                    if ( mPlayheads[playheadIndex].triggerSamplePoints.size ( ) == 0 )
-                    {
-                        if ( mLoopPlayheads )
-                        {
-                            mPlayheads[playheadIndex].sampleIndex = 0;
-                            CalculateTriggerPoints ( mPlayheads[playheadIndex] );
-                        }
-                        else
-                        {
-                            playheadsToKillThisBuffer.push_back ( mPlayheads[playheadIndex].playheadID );
-                            break;
-                        }
-                    }
-
-                    // crossfade jump
-                    if ( mPlayheads[playheadIndex].crossfading )
-                    {
-                        CrossfadeAudioSegment ( &playheadBuffer, &playheadBufferPosition, &mPlayheads[playheadIndex], false );
-                        
-                        if ( mPlayheads[playheadIndex].crossfading ) { break; }
-                    }
-
-                    // exit loop - no more space in outbuffer, no more triggers hit
-                    if ( (playheadBuffer.getNumFrames ( ) - playheadBufferPosition) < (mPlayheads[playheadIndex].triggerSamplePoints.front ( ) - mPlayheads[playheadIndex].sampleIndex) )
-                    {
-                        FillAudioSegment ( &playheadBuffer, &playheadBufferPosition, &mPlayheads[playheadIndex], true );
-                        break;
-                    }
-
-                    // fill audio up to the next trigger, already established that there is enough space in outBuffer
-                    FillAudioSegment ( &playheadBuffer, &playheadBufferPosition, &mPlayheads[playheadIndex], false );
-
-                    // after this point it is assumed that a new trigger has been reached, perform jump checks for this trigger
-
-                    int requiredSamples = mCrossfadeSampleLength;
-                    if ( mPlayheads[playheadIndex].sampleIndex + requiredSamples >= mRawView->GetAudioData ( )->raw[mPlayheads[playheadIndex].fileIndex].getNumFrames ( ) ) { continue; }
-                    std::uniform_int_distribution<> dis ( 0, 1000 );
-                    int randomValue = dis ( mRandomGen );
-                    if ( randomValue > mCrossoverJumpChanceX1000 ) { continue; }
-                    if ( mCorpusMeshMutex.try_lock ( ) )
-                        // TODO - investigate if this lock could work differently, currently this would cause a brief moment of no possible jumps
-                    {
-                        std::lock_guard<std::mutex> lock ( mCorpusMeshMutex, std::adopt_lock );
-
-                        size_t timePointIndex = mPlayheads[playheadIndex].sampleIndex / mRawView->GetHopSize ( );
-                        glm::vec3 playheadPosition = mCorpusMesh[mPlayheads[playheadIndex].fileIndex].getVertex ( timePointIndex );
-                        Utilities::PointFT nearestPoint;
-                        Utilities::PointFT currentPoint; currentPoint.file = mPlayheads[playheadIndex].fileIndex; currentPoint.time = timePointIndex;
-
-                        if ( !mPointPicker->FindNearestToPosition ( playheadPosition, nearestPoint, currentPoint,
-                                                                    mMaxJumpDistanceSpaceX1000, mMaxJumpTargets, mJumpSameFileAllowed,
-                                                                    mJumpSameFileMinTimeDiff, requiredSamples, *mRawView->GetAudioData ( ), mRawView->GetHopSize ( ) ) )
-                        {
-                            continue;
-                        }
-
-                        if ( mRawView->GetAudioData ( )->loaded[nearestPoint.file] == false ) { continue; }
-
-                        mPlayheads[playheadIndex].crossfading = true;
-                        mPlayheads[playheadIndex].jumpFileIndex = nearestPoint.file;
-                        mPlayheads[playheadIndex].jumpSampleIndex = nearestPoint.time * mRawView->GetHopSize ( );
-                        mPlayheads[playheadIndex].crossfadeCurrentSample = 0;
-                        mPlayheads[playheadIndex].crossfadeSampleLength = requiredSamples;
-                    }
-                }
+        // after this point it is assumed that a new trigger has been reached, perform jump checks for this trigger
 
-                // if playhead is marked for death, apply a fade out and remove from playheads
-                {
-                    std::vector<size_t>::iterator it = std::find ( playheadsToKillThisBuffer.begin ( ), playheadsToKillThisBuffer.end ( ), mPlayheads[playheadIndex].playheadID );
-                    size_t killIndex = std::distance ( playheadsToKillThisBuffer.begin ( ), it );
-                    if ( it != playheadsToKillThisBuffer.end ( ) )
-                    {
-                        for ( size_t i = 0; i < playheadBuffer.getNumFrames ( ); i++ )
-                        {
-                            float gain = cos ( (float)i / (float)playheadBuffer.getNumFrames ( ) * 0.5 * M_PI );
-                            playheadBuffer.getSample ( i, 0 ) *= gain;
-                            playheadBuffer.getSample ( i, 1 ) *= gain;
-                        }
-
-                        playheadsToKillThisBuffer.erase ( playheadsToKillThisBuffer.begin ( ) + killIndex );
-
-                        mPlayheads.erase ( mPlayheads.begin ( ) + playheadIndex );
-                        playheadIndex--;
-                    }
-                }
+        int requiredSamples = context.crossfadeSampleLength;
+        size_t timePointIndex = playhead.sampleIndex / mRawView->GetHopSize ( );
 
-                // processing done, add to outBuffer
-                for ( size_t sampleIndex = 0; sampleIndex < outBuffer.getNumFrames ( ); sampleIndex++ )
+        // keep the planner a few triggers ahead, whether or not a jump happens here
+        PlanJumpsAhead ( playhead, playhead.fileIndex, timePointIndex, context.jumpRules );
+
+        if ( context.streamed )
+        {
+            // a jump chosen at the previous trigger is taken here, but only if its audio has already been prefetched
+            if ( playhead.jumpPending )
+            {
+                playhead.jumpPending = false;
+
+                if ( playhead.sampleIndex + requiredSamples < mRawView->GetAudioData ( )->length[playhead.fileIndex] &&
+                    mStreamer.Available ( playhead.jumpStreamSlot ) >= (size_t)requiredSamples )
                 {
-                    outBuffer.getSample ( sampleIndex, 0 ) += playheadBuffer.getSample ( sampleIndex, 0 );
-                    outBuffer.getSample ( sampleIndex, 1 ) += playheadBuffer.getSample ( sampleIndex, 1 );
+                    playhead.crossfading = true;
+                    playhead.crossfadeCurrentSample = 0;
+                    playhead.crossfadeSampleLength = requiredSamples;
+                    PlanJumpsAhead ( playhead, playhead.jumpFileIndex, playhead.jumpSampleIndex / mRawView->GetHopSize ( ), context.jumpRules );
+                    scratch.jumpsTaken++;
+                    continue;
                 }
+
+                mStreamer.Cancel ( playhead.jumpStreamSlot );
+                scratch.jumpsSkipped[PREFETCH_LATE]++;
             }
 
-            // multiply by global volume
-            for ( size_t sampleIndex = 0; sampleIndex < outBuffer.getNumFrames ( ); sampleIndex++ )
+            // no jump can be taken at the final trigger, so prefetch the loop point in its place
+            if ( TriggerPointsFrom ( playhead ) <= 2 )
             {
-                outBuffer.getSample ( sampleIndex, 0 ) *= volume;
-                outBuffer.getSample ( sampleIndex, 1 ) *= volume;
+                if ( context.loopPlayheads && !playhead.loopPrefetched )
+                {
+                    mStreamer.Request ( playhead.jumpStreamSlot, playhead.fileIndex, 0 );
+                    playhead.loopPrefetched = true;
+                }
+                continue;
             }
         }
 
-        // get playhead post-processing location info for main thread
-        if ( mVisualPlayheadUpdateMutex.try_lock ( ) )
+        if ( playhead.sampleIndex + requiredSamples >= mRawView->GetAudioData ( )->length[playhead.fileIndex] ) { continue; }
+        std::uniform_int_distribution<> dis ( 0, 1000 );
+        int randomValue = dis ( playhead.randomGen );
+        if ( randomValue > context.crossoverJumpChanceX1000 ) { continue; }
+
+        // the target was chosen by the planner thread, if it hasn't got this far yet there is simply no jump here
+        Utilities::PointFT nearestPoint;
+        if ( playhead.planSlot < 0 ) { scratch.jumpsSkipped[NO_PLAN_SLOT]++; continue; }
+
+        JumpPlanner::DecisionResult decision = mJumpPlanner.TakeDecision ( playhead.planSlot, playhead.fileIndex, timePointIndex, nearestPoint );
+        if ( decision == JumpPlanner::DecisionResult::NOT_READY ) { scratch.jumpsSkipped[PLANNER_BEHIND]++; continue; }
+        if ( decision == JumpPlanner::DecisionResult::NO_TARGET ) { scratch.jumpsSkipped[NO_TARGET]++; continue; }
+
+        if ( mRawView->GetAudioData ( )->loaded[nearestPoint.file] == false ) { scratch.jumpsSkipped[TARGET_NOT_RESIDENT]++; continue; }
+
+        if ( context.cache != nullptr )
+        {
+            playhead.jumpCachedSamples = context.cache->Pin ( nearestPoint.file, true );
+            if ( playhead.jumpCachedSamples == nullptr ) { scratch.jumpsSkipped[TARGET_NOT_RESIDENT]++; continue; } // evicted since the search
+        }
+
+        if ( context.streamed )
         {
-            std::lock_guard<std::mutex> lock ( mVisualPlayheadUpdateMutex, std::adopt_lock );
+            playhead.jumpPending = true;
+            playhead.jumpFileIndex = nearestPoint.file;
+            playhead.jumpSampleIndex = nearestPoint.time * mRawView->GetHopSize ( );
+            mStreamer.Request ( playhead.jumpStreamSlot, playhead.jumpFileIndex, playhead.jumpSampleIndex );
+            continue;
+        }
 
-            mVisualPlayheads.clear ( );
+        playhead.crossfading = true;
+        playhead.jumpFileIndex = nearestPoint.file;
+        playhead.jumpSampleIndex = nearestPoint.time * mRawView->GetHopSize ( );
+        playhead.crossfadeCurrentSample = 0;
+        playhead.crossfadeSampleLength = requiredSamples;
+        PlanJumpsAhead ( playhead, nearestPoint.file, nearestPoint.time, context.jumpRules );
+        scratch.jumpsTaken++;
+    }
 
+    // if playhead is marked for death, fade it out, however near the end of the buffer the kill landed the fade keeps its full length, carrying on
+    // through the next buffers until done, then it is removed from playheads once every playhead has been processed
+    if ( playhead.killRequested )
+    {
+        size_t frames = playheadBuffer.getNumFrames ( );
+        size_t fadeStart = std::min ( playhead.killOffset, frames );
+        size_t fadeFrames = std::min ( frames - fadeStart, (size_t)DEFAULT_KILL_FADE_SAMPLE_LENGTH - playhead.killFadeFrames );
+        float* samples = playheadBuffer.getBuffer ( ).data ( );
+
+        Utilities::MixKernels::FadeOut ( samples + fadeStart * 2, fadeFrames,
+                                         (float)playhead.killFadeFrames / DEFAULT_KILL_FADE_SAMPLE_LENGTH, 1.0f / DEFAULT_KILL_FADE_SAMPLE_LENGTH );
+        std::fill ( samples + ( fadeStart + fadeFrames ) * 2, samples + frames * 2, 0.0f );
+
+        playhead.killOffset = 0;
+        playhead.killFadeFrames += fadeFrames;
+        playhead.killed = playhead.killFadeFrames >= DEFAULT_KILL_FADE_SAMPLE_LENGTH;
+    }
+}
+
+void Explorer::AudioPlayback::ApplyCommands ( size_t bufferFrames, bool audioProcessingBlocked, bool streamed, AudioCache* cache, const JumpPlanner::Rules& jumpRules )
+{
+    uint64_t bufferStart = mSampleTime;
+
+    while ( const PlayheadCommand* command = mCommands.Peek ( ) )
+    {
+        if ( command->atSample >= bufferStart + bufferFrames ) { break; } // not due yet, everything sent after it waits too
+        size_t offset = command->atSample > bufferStart ? (size_t)( command->atSample - bufferStart ) : 0;
+
+        if ( command->type == PlayheadCommand::Type::Create )
+        {
+            Utilities::AudioPlayhead newPlayhead ( command->playheadID, command->fileIndex, command->sampleIndex );
+            newPlayhead.bufferStartOffset = offset;
+            newPlayhead.randomGen.seed ( mRandomGen ( ) );
+
+            // the voice pool is full, CreatePlayhead refuses before this can happen unless playheads are being created faster than they are killed
+            if ( mPlayheads.size ( ) < mPlayheads.capacity ( ) && ( !streamed || AttachStreamSlots ( newPlayhead ) ) )
+            {
+                if ( cache != nullptr ) { newPlayhead.cachedSamples = cache->Pin ( newPlayhead.fileIndex, true ); }
+                newPlayhead.planSlot = mJumpPlanner.AcquireSlot ( );
+                PlanJumpsAhead ( newPlayhead, newPlayhead.fileIndex, newPlayhead.sampleIndex / mRawView->GetHopSize ( ), jumpRules );
+                mPlayheads.push_back ( newPlayhead );
+            }
+            else { mCreatesRefused.fetch_add ( 1, std::memory_order_relaxed ); }
+        }
+        else if ( command->type == PlayheadCommand::Type::Kill )
+        {
             for ( size_t i = 0; i < mPlayheads.size ( ); i++ )
             {
-                mVisualPlayheads.push_back ( Utilities::VisualPlayhead ( mPlayheads[i].playheadID, mPlayheads[i].fileIndex, mPlayheads[i].sampleIndex ) );
+                if ( mPlayheads[i].playheadID != command->playheadID ) { continue; }
+
+                if ( audioProcessingBlocked )
+                {
+                    ReleasePlayheadSources ( mPlayheads[i] );
+                    mPlayheads.erase ( mPlayheads.begin ( ) + i );
+                    mVoicesKilled.fetch_add ( 1, std::memory_order_relaxed );
+                }
+                else if ( !mPlayheads[i].killRequested ) // the first kill sent decides where the fade starts
+                {
+                    mPlayheads[i].killRequested = true;
+                    mPlayheads[i].killOffset = offset;
+                    mVoicesKilled.fetch_add ( 1, std::memory_order_relaxed );
+                }
+                break;
             }
         }
+        else if ( command->type == PlayheadCommand::Type::SetVolume )
+        {
+            size_t change = std::min ( mVolumeChangeCount, kMaxVolumeChangesPerBuffer - 1 );
+            mVolumeChanges[change] = { offset, (double)command->volumeX1000 / 1000.0 };
+            mVolumeChangeCount = change + 1;
+        }
 
-        mActivePlayheads = mPlayheads.size ( );
+        mCommands.Drop ( );
     }
 }
 
-void Explorer::AudioPlayback::FillAudioSegment ( ofSoundBuffer* outBuffer, size_t* outBufferPosition, Utilities::AudioPlayhead* playhead, bool outBufferFull )
+void Explorer::AudioPlayback::ApplyVolume ( ofSoundBuffer& outBuffer )
 {
-    size_t segmentLength = playhead->triggerSamplePoints.front ( ) - playhead->sampleIndex;
+    // changes arrive in the order they were sent, not necessarily the order of their offsets, equal offsets keep the later one last
+    for ( size_t i = 1; i < mVolumeChangeCount; i++ )
+    {
+        for ( size_t j = i; j > 0 && mVolumeChanges[j - 1].first > mVolumeChanges[j].first; j-- ) { std::swap ( mVolumeChanges[j - 1], mVolumeChanges[j] ); }
+    }
+
+    // scaled a run at a time, each run ending where the next change takes over
+    size_t change = 0;
+    size_t runStart = 0;
+    while ( runStart < outBuffer.getNumFrames ( ) )
+    {
+        while ( change < mVolumeChangeCount && mVolumeChanges[change].first <= runStart ) { mVolume = mVolumeChanges[change++].second; }
+
+        size_t runEnd = change < mVolumeChangeCount ? std::min ( mVolumeChanges[change].first, outBuffer.getNumFrames ( ) ) : outBuffer.getNumFrames ( );
+        Utilities::MixKernels::Scale ( outBuffer.getBuffer ( ).data ( ) + runStart * 2, ( runEnd - runStart ) * 2, (float)mVolume );
+        runStart = runEnd;
+    }
+
+    mVolumeChangeCount = 0;
+}
+
+template <typename SampleType>
+bool Explorer::AudioPlayback::FillAudioSegment ( ofSoundBuffer* outBuffer, size_t* outBufferPosition, Utilities::AudioPlayhead* playhead, bool outBufferFull,
+                                                const VoiceRenderContext& context, VoiceScratch& scratch )
+{
+    size_t segmentLength = NextTriggerPoint ( *playhead ) - playhead->sampleIndex;
 
     if ( outBufferFull && segmentLength > (outBuffer->getNumFrames ( ) - *outBufferPosition) ) // cut off early if outBuffer is full
     {
         segmentLength = outBuffer->getNumFrames ( ) - *outBufferPosition;
     }
     
-    if ( segmentLength == 0 ) { return; }
+    if ( segmentLength == 0 ) { return true; }
+
+    size_t availableLength = segmentLength;
+    const SampleType* source = GetSourceSamples<SampleType> ( playhead->fileIndex, playhead->sampleIndex, playhead->streamSlot, playhead->cachedSamples, &availableLength, scratch.stream[0].data ( ) );
+    bool segmentComplete = availableLength == segmentLength;
+    segmentLength = availableLength;
+
+    if ( segmentLength == 0 ) { return false; }
 
     float panGainL = 1.0f, panGainR = 1.0f;
-    double panningStrength = (double)mPanningStrengthX1000 / 1000.0;
-    if ( mDynamicPanEnabled && panningStrength > 0.0 )
+    if ( context.panningStrength > 0.0f )
     {
         size_t timePointIndex = playhead->sampleIndex / mRawView->GetHopSize ( );
-        float pan = mRawView->GetTrailData ( )->raw[playhead->fileIndex][timePointIndex][mDynamicPanDimensionIndex];
-        float panNorm = 0.5f;
-        {
-            std::lock_guard <std::mutex> lock ( mDimensionBoundsMutex );
-
-            panNorm = (float)(                 pan                            - mDimensionBounds.min[mDynamicPanDimensionIndex])
-                    / (float)(mDimensionBounds.max[mDynamicPanDimensionIndex] - mDimensionBounds.min[mDynamicPanDimensionIndex]);
-        }
+        float pan = mRawView->GetTrailData ( )->raw[playhead->fileIndex][timePointIndex][context.panDimensionIndex];
+        float panNorm = (float)( pan - context.panMin ) / (float)( context.panMax - context.panMin );
         panNorm = glm::clamp ( panNorm, 0.0f, 1.0f );
-        panGainL = cos ( panNorm * 0.5 * M_PI );
-        panGainR = sin ( panNorm * 0.5 * M_PI );
-
-        panGainL = 1.0f - panningStrength * (1.0f - panGainL);
-        panGainR = 1.0f - panningStrength * (1.0f - panGainR);
+        Utilities::MixKernels::PanGains ( panNorm, context.panningStrength, panGainL, panGainR );
+        // TODO - could have a power curve here instead of linear - something like: float result = 1.0f - pow(Y, power) * (1.0f - X);
     }
 
-    for ( size_t i = 0; i < segmentLength; i++ )
-    {
-        outBuffer->getSample ( *outBufferPosition + i, 0 ) = mRawView->GetAudioData ( )->raw[playhead->fileIndex].getSample ( playhead->sampleIndex + i, 0 ) * panGainL;
-        outBuffer->getSample ( *outBufferPosition + i, 1 ) = mRawView->GetAudioData ( )->raw[playhead->fileIndex].getSample ( playhead->sampleIndex + i, 0 ) * panGainR;
-    }
+    Utilities::MixKernels::PanToStereo ( source, segmentLength, panGainL, panGainR, outBuffer->getBuffer ( ).data ( ) + *outBufferPosition * 2 );
 
     playhead->sampleIndex += segmentLength;
     *outBufferPosition += segmentLength;
+
+    return segmentComplete;
 }
 
-void Explorer::AudioPlayback::CrossfadeAudioSegment ( ofSoundBuffer* outBuffer, size_t* outBufferPosition, Utilities::AudioPlayhead* playhead, bool outBufferFull )
+template <typename SampleType>
+void Explorer::AudioPlayback::CrossfadeAudioSegment ( ofSoundBuffer* outBuffer, size_t* outBufferPosition, Utilities::AudioPlayhead* playhead, bool outBufferFull,
+                                                     const VoiceRenderContext& context, VoiceScratch& scratch )
 {
     //if ( mPlayheads[playheadIndex].crossfading )
     //{
@@ -436,56 +769,39 @@ void Explorer::AudioPlayback::CrossfadeAudioSegment ( ofSoundBuffer* outBuffer,
     size_t bufferSpace = outBuffer->getNumFrames ( ) - *outBufferPosition;
     if ( crossfadeSamplesLeft > bufferSpace ) { crossfadeSamplesLeft = bufferSpace; }
 
+    // the shorter of the two sources decides how far the crossfade can get, the rest continues next buffer
+    size_t availableA = crossfadeSamplesLeft, availableB = crossfadeSamplesLeft;
+    if ( playhead->streamSlot >= 0 )
+    {
+        availableA = std::min ( availableA, mStreamer.Available ( playhead->streamSlot ) );
+        availableB = std::min ( availableB, mStreamer.Available ( playhead->jumpStreamSlot ) );
+        crossfadeSamplesLeft = std::min ( availableA, availableB );
+        availableA = availableB = crossfadeSamplesLeft;
+    }
+
+    const SampleType* sourceA = GetSourceSamples<SampleType> ( playhead->fileIndex, playhead->sampleIndex, playhead->streamSlot, playhead->cachedSamples, &availableA, scratch.stream[0].data ( ) );
+    const SampleType* sourceB = GetSourceSamples<SampleType> ( playhead->jumpFileIndex, playhead->jumpSampleIndex, playhead->jumpStreamSlot, playhead->jumpCachedSamples, &availableB, scratch.stream[1].data ( ) );
+
     float panStartNorm = 0.5f, panEndNorm = 0.5f;
-    double panningStrength = (double)mPanningStrengthX1000 / 1000.0;
-    if ( mDynamicPanEnabled && panningStrength > 0.0 )
+    if ( context.panningStrength > 0.0f )
     {
         size_t thisTimePointIndex = playhead->sampleIndex / mRawView->GetHopSize ( );
         size_t jumpTimePointIndex = playhead->jumpSampleIndex / mRawView->GetHopSize ( );
 
-        float panStart = mRawView->GetTrailData ( )->raw[playhead->fileIndex][thisTimePointIndex][mDynamicPanDimensionIndex];
-        float panEnd = mRawView->GetTrailData ( )->raw[playhead->jumpFileIndex][jumpTimePointIndex][mDynamicPanDimensionIndex];
+        float panStart = mRawView->GetTrailData ( )->raw[playhead->fileIndex][thisTimePointIndex][context.panDimensionIndex];
+        float panEnd = mRawView->GetTrailData ( )->raw[playhead->jumpFileIndex][jumpTimePointIndex][context.panDimensionIndex];
 
-        {
-            std::lock_guard <std::mutex> lock ( mDimensionBoundsMutex );
-
-            panStartNorm    = (float)(panStart - mDimensionBounds.min[mDynamicPanDimensionIndex])
-                            / (float)(mDimensionBounds.max[mDynamicPanDimensionIndex] - mDimensionBounds.min[mDynamicPanDimensionIndex]);
-            panEndNorm      = (float)(panEnd - mDimensionBounds.min[mDynamicPanDimensionIndex])
-                            / (float)(mDimensionBounds.max[mDynamicPanDimensionIndex] - mDimensionBounds.min[mDynamicPanDimensionIndex]);
-        }
+        panStartNorm    = (float)( panStart - context.panMin ) / (float)( context.panMax - context.panMin );
+        panEndNorm      = (float)( panEnd - context.panMin ) / (float)( context.panMax - context.panMin );
 
         panStartNorm = glm::clamp ( panStartNorm, 0.0f, 1.0f );
         panEndNorm = glm::clamp ( panEndNorm, 0.0f, 1.0f );
     }
 
-    for ( size_t i = 0; i < crossfadeSamplesLeft; i++ )
-    {
-        float crossfadeProgress = (float)(playhead->crossfadeCurrentSample + i) / (float)playhead->crossfadeSampleLength;
-
-        float gain_A = cos ( crossfadeProgress * 0.5 * M_PI );
-        float gain_B = sin ( crossfadeProgress * 0.5 * M_PI );
-
-        float sample_A = mRawView->GetAudioData ( )->raw[playhead->fileIndex].getSample ( playhead->sampleIndex + i, 0 );
-        float sample_B = mRawView->GetAudioData ( )->raw[playhead->jumpFileIndex].getSample ( playhead->jumpSampleIndex + i, 0 );
-        float samplePostCrossfade = (sample_A * gain_A) + (sample_B * gain_B);
-
-        float panGainL = 1.0f, panGainR = 1.0f;
-        if ( mDynamicPanEnabled && panningStrength > 0.0 )
-        {
-            float panPostCrossfade = panStartNorm + (panEndNorm - panStartNorm) * crossfadeProgress;
-            panGainL = cos ( panPostCrossfade * 0.5 * M_PI );
-            panGainR = sin ( panPostCrossfade * 0.5 * M_PI );
-
-            panGainL = 1.0f - panningStrength * (1.0f - panGainL);
-            panGainR = 1.0f - panningStrength * (1.0f - panGainR);
-            // TODO - could have a power curve here instead of linear - something like: float result = 1.0f - pow(Y, power) * (1.0f - X);
-            // TODO - same thing further down in FillAudioSegment();
-        }
-
-        outBuffer->getSample ( *outBufferPosition + i, 0 ) = samplePostCrossfade * panGainL;
-        outBuffer->getSample ( *outBufferPosition + i, 1 ) = samplePostCrossfade * panGainR;
-    }
+    // a strength of 0 leaves the pan at unity gain, so one kernel covers dynamic pan on and off
+    Utilities::MixKernels::CrossfadeToStereo (  sourceA, sourceB, crossfadeSamplesLeft,
+                                                (float)playhead->crossfadeCurrentSample / (float)playhead->crossfadeSampleLength, 1.0f / (float)playhead->crossfadeSampleLength,
+                                                panStartNorm, panEndNorm, context.panningStrength, outBuffer->getBuffer ( ).data ( ) + *outBufferPosition * 2 );
 
     playhead->crossfadeCurrentSample += crossfadeSamplesLeft;
     playhead->sampleIndex += crossfadeSamplesLeft;
@@ -495,13 +811,26 @@ void Explorer::AudioPlayback::CrossfadeAudioSegment ( ofSoundBuffer* outBuffer,
     if ( playhead->crossfadeCurrentSample >= playhead->crossfadeSampleLength )
     {
         playhead->crossfading = false;
+
+        if ( playhead->jumpCachedSamples != nullptr )
+        {
+            mRawView->GetAudioCache ( )->Unpin ( playhead->fileIndex );
+            playhead->cachedSamples = playhead->jumpCachedSamples;
+            playhead->jumpCachedSamples = nullptr;
+        }
+
         playhead->fileIndex = playhead->jumpFileIndex;
         playhead->sampleIndex = playhead->jumpSampleIndex;
-        CalculateTriggerPoints ( *playhead );
+
+        if ( playhead->streamSlot >= 0 )
+        {
+            std::swap ( playhead->streamSlot, playhead->jumpStreamSlot );
+            mStreamer.Cancel ( playhead->jumpStreamSlot );
+        }
     }
 }
 
-bool Explorer::AudioPlayback::CreatePlayhead ( size_t fileIndex, size_t timePointIndex )
+bool Explorer::AudioPlayback::CreatePlayhead ( size_t fileIndex, size_t timePointIndex, uint64_t atSample )
 {
     if ( bMissingOutputFlag )
     {
@@ -523,53 +852,240 @@ bool Explorer::AudioPlayback::CreatePlayhead ( size_t fileIndex, size_t timePoin
         ofLogError ( "AudioPlayback" ) << "No files in dataset, failed to create new playhead";
         return false;
     }
+    else if ( !mRawView->GetAudioData ( )->loaded[fileIndex] )
+    {
+        ofLogError ( "AudioPlayback" ) << "File not loaded in memory, failed to create playhead for " << mRawView->GetDataset ( )->fileList[fileIndex];
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock ( mCommandSendMutex );
 
+    // queued commands are counted as if they were all new playheads, a kill still queued can only make this refuse early
+    size_t maxPlayheads = IsStreamed ( ) ? std::min ( (size_t)DEFAULT_MAX_PLAYHEADS, mStreamer.GetMaxPlayheads ( ) ) : DEFAULT_MAX_PLAYHEADS;
+    if ( mActivePlayheads + mCommands.Size ( ) >= maxPlayheads )
     {
-        std::lock_guard<std::mutex> lock ( mNewPlayheadMutex );
-        if ( mNewPlayheads.size ( ) > 3 )
-        {
-            ofLogWarning ( "AudioPlayback" ) << "Too many playheads queued already, failed to create new playhead";
-            return false;
-        }
+        ofLogWarning ( "AudioPlayback" ) << "All " << maxPlayheads << ( IsStreamed ( ) ? " streamed" : "" ) << " playheads in use, failed to create new playhead";
+        return false;
     }
 
-    if ( mRawView->GetAudioData ( )->loaded[fileIndex] )
+    PlayheadCommand command;
+    command.type = PlayheadCommand::Type::Create;
+    command.atSample = atSample;
+    command.playheadID = playheadCounter;
+    command.fileIndex = fileIndex;
+    command.sampleIndex = timePointIndex * mRawView->GetHopSize ( );
+
+    if ( !SendCommand ( command, DEFAULT_PLAYHEAD_COMMAND_RESERVE ) )
     {
-        size_t sampleIndex = timePointIndex * mRawView->GetHopSize ( );
-        Utilities::AudioPlayhead newPlayhead ( playheadCounter, fileIndex, sampleIndex );
-        playheadCounter++;
+        ofLogWarning ( "AudioPlayback" ) << "Too many playhead commands queued already, failed to create new playhead";
+        return false;
+    }
 
-        CalculateTriggerPoints ( newPlayhead );
+    playheadCounter++;
 
-        {
-            std::lock_guard<std::mutex> lock ( mNewPlayheadMutex );
-            mNewPlayheads.push ( newPlayhead );
-        }
+    if ( mRawView->GetAudioCache ( ) != nullptr ) { mRawView->GetAudioCache ( )->RequestLoad ( fileIndex ); } // start loading before the audio thread asks
+
+    return true;
+}
+
+bool Explorer::AudioPlayback::KillPlayhead ( size_t playheadID, uint64_t atSample )
+{
+    std::lock_guard<std::mutex> lock ( mCommandSendMutex );
+
+    PlayheadCommand command;
+    command.type = PlayheadCommand::Type::Kill;
+    command.atSample = atSample;
+    command.playheadID = playheadID;
+
+    if ( !SendCommand ( command, 0 ) )
+    {
+        ofLogWarning ( "AudioPlayback" ) << "Playhead command queue is full, failed to kill playhead " << playheadID;
+        return false;
+    }
+
+    return true;
+}
 
+bool Explorer::AudioPlayback::SetVolumeX1000 ( int volumeX1000, uint64_t atSample )
+{
+    // with no stream running nothing would take the command off the queue, and the audio thread can't be mid buffer while this lock is held
+    if ( !bStreamStarted )
+    {
+        std::lock_guard<std::mutex> killAudioLock ( mKillAudioOnlyAudioThreadBlockingMutex );
+        mVolume = (double)volumeX1000 / 1000.0;
         return true;
     }
-    else
+
+    std::lock_guard<std::mutex> lock ( mCommandSendMutex );
+
+    PlayheadCommand command;
+    command.type = PlayheadCommand::Type::SetVolume;
+    command.atSample = atSample;
+    command.volumeX1000 = volumeX1000;
+
+    if ( !SendCommand ( command, 0 ) )
     {
-        ofLogError ( "AudioPlayback" ) << "File not loaded in memory, failed to create playhead for " << mRawView->GetDataset ( )->fileList[fileIndex];
+        ofLogWarning ( "AudioPlayback" ) << "Playhead command queue is full, failed to set volume";
         return false;
     }
+
+    return true;
+}
+
+bool Explorer::AudioPlayback::SendCommand ( const PlayheadCommand& command, size_t placesToLeave )
+{
+    // this side is the only one pushing, so the space seen here can only grow before the push
+    if ( mCommands.Capacity ( ) - mCommands.Size ( ) > placesToLeave && mCommands.Push ( command ) ) { return true; }
+
+    mCommandsDropped.fetch_add ( 1, std::memory_order_relaxed );
+    return false;
 }
 
-bool Explorer::AudioPlayback::KillPlayhead ( size_t playheadID )
+const char* Explorer::AudioPlayback::GetJumpSkipCauseName ( int cause )
 {
+    switch ( cause )
     {
-        std::lock_guard<std::mutex> lock ( mNewPlayheadMutex );
-        mPlayheadsToKill.push ( playheadID );
+        case PLANNER_BEHIND: return "planner_behind";
+        case NO_PLAN_SLOT: return "no_plan_slot";
+        case NO_TARGET: return "no_target";
+        case TARGET_NOT_RESIDENT: return "target_not_resident";
+        case PREFETCH_LATE: return "prefetch_late";
+        default: return "unknown";
     }
+}
 
-    return true;
+Explorer::AudioPlayback::Telemetry Explorer::AudioPlayback::GetTelemetry ( ) const
+{
+    Telemetry telemetry;
+    telemetry.callbacks = mCallbacks.load ( std::memory_order_relaxed );
+    for ( int i = 0; i < kLoadHistogramBuckets; i++ ) { telemetry.loadHistogram[i] = mLoadHistogram[i].load ( std::memory_order_relaxed ); }
+    telemetry.loadPercent = mLoadPercent.load ( std::memory_order_relaxed );
+    telemetry.peakLoadPercent = mPeakLoadPercent.load ( std::memory_order_relaxed );
+    telemetry.overruns = mOverruns.load ( std::memory_order_relaxed );
+    telemetry.lateCallbacks = mLateCallbacks.load ( std::memory_order_relaxed );
+    telemetry.jumpsTaken = mJumpsTaken.load ( std::memory_order_relaxed );
+    for ( int i = 0; i < JUMP_SKIP_CAUSES; i++ ) { telemetry.jumpsSkipped[i] = mJumpsSkipped[i].load ( std::memory_order_relaxed ); }
+    telemetry.voicesEnded = mVoicesEnded.load ( std::memory_order_relaxed );
+    telemetry.voicesKilled = mVoicesKilled.load ( std::memory_order_relaxed );
+    telemetry.voicesShed = mVoicesShed.load ( std::memory_order_relaxed );
+    telemetry.createsRefused = mCreatesRefused.load ( std::memory_order_relaxed );
+    telemetry.commandsDropped = mCommandsDropped.load ( std::memory_order_relaxed );
+    telemetry.qualityLevel = mGovernor.GetLevel ( );
+    return telemetry;
+}
+
+void Explorer::AudioPlayback::ResetTelemetry ( )
+{
+    mCallbacks = 0;
+    for ( auto& bucket : mLoadHistogram ) { bucket = 0; }
+    mLoadPercent = 0.0f;
+    mPeakLoadPercent = 0.0f;
+    mOverruns = 0;
+    mLateCallbacks = 0;
+    mJumpsTaken = 0;
+    for ( auto& skipped : mJumpsSkipped ) { skipped = 0; }
+    mVoicesEnded = 0;
+    mVoicesKilled = 0;
+    mVoicesShed = 0;
+    mCreatesRefused = 0;
+    mCommandsDropped = 0;
+
+    for ( auto& voiceScratch : mVoiceScratch )
+    {
+        voiceScratch.jumpsTaken = 0;
+        std::fill ( std::begin ( voiceScratch.jumpsSkipped ), std::end ( voiceScratch.jumpsSkipped ), 0 );
+        voiceScratch.voicesEnded = 0;
+    }
+
+    mLastCallbackStart = std::chrono::steady_clock::time_point ( );
+    mPeakWindowSeconds = 0.0;
+    mPeakWindowLoadPercent = 0.0f;
+}
+
+float Explorer::AudioPlayback::RecordCallbackTime ( std::chrono::steady_clock::time_point callbackStart, size_t frames, size_t sampleRate )
+{
+    if ( frames == 0 || sampleRate == 0 ) { return 0.0f; }
+
+    double bufferSeconds = (double)frames / (double)sampleRate;
+    double elapsedSeconds = std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - callbackStart ).count ( );
+    float loadPercent = (float)( elapsedSeconds / bufferSeconds * 100.0 );
+
+    int bucket = 0;
+    while ( bucket < kLoadHistogramBuckets - 1 && loadPercent >= kLoadHistogramEdgesPercent[bucket] ) { bucket++; }
+    mLoadHistogram[bucket].fetch_add ( 1, std::memory_order_relaxed );
+    mCallbacks.fetch_add ( 1, std::memory_order_relaxed );
+    if ( loadPercent >= 100.0f ) { mOverruns.fetch_add ( 1, std::memory_order_relaxed ); }
+
+    if ( !bOffline && mLastCallbackStart != std::chrono::steady_clock::time_point ( ) )
+    {
+        double intervalSeconds = std::chrono::duration<double> ( callbackStart - mLastCallbackStart ).count ( );
+        if ( intervalSeconds > bufferSeconds * 1.5 ) { mLateCallbacks.fetch_add ( 1, std::memory_order_relaxed ); }
+    }
+    mLastCallbackStart = callbackStart;
+
+    // one pole smoothing with a time constant of about half a second of audio, whatever the buffer size
+    float smoothing = (float)std::min ( 1.0, bufferSeconds / 0.5 );
+    float smoothedLoadPercent = mLoadPercent.load ( std::memory_order_relaxed );
+    mLoadPercent.store ( smoothedLoadPercent + ( loadPercent - smoothedLoadPercent ) * smoothing, std::memory_order_relaxed );
+
+    mPeakWindowLoadPercent = std::max ( mPeakWindowLoadPercent, loadPercent );
+    mPeakWindowSeconds += bufferSeconds;
+    if ( mPeakWindowSeconds >= 1.0 )
+    {
+        mPeakLoadPercent.store ( mPeakWindowLoadPercent, std::memory_order_relaxed );
+        mPeakWindowLoadPercent = 0.0f;
+        mPeakWindowSeconds = 0.0;
+    }
+
+    return loadPercent;
+}
+
+void Explorer::AudioPlayback::ShedVoices ( size_t count )
+{
+    // playheads are kept in the order they were created, so the oldest go first
+    for ( size_t i = 0; i < mPlayheads.size ( ) && count > 0; i++ )
+    {
+        if ( mPlayheads[i].killRequested ) { continue; }
+
+        mPlayheads[i].killRequested = true;
+        mPlayheads[i].killOffset = 0;
+        mVoicesShed.fetch_add ( 1, std::memory_order_relaxed );
+        count--;
+    }
+}
+
+void Explorer::AudioPlayback::GatherVoiceTelemetry ( )
+{
+    auto add = [] ( std::atomic<uint64_t>& counter, uint64_t& count ) { if ( count > 0 ) { counter.fetch_add ( count, std::memory_order_relaxed ); count = 0; } };
+
+    for ( auto& voiceScratch : mVoiceScratch )
+    {
+        add ( mJumpsTaken, voiceScratch.jumpsTaken );
+        for ( int i = 0; i < JUMP_SKIP_CAUSES; i++ ) { add ( mJumpsSkipped[i], voiceScratch.jumpsSkipped[i] ); }
+        add ( mVoicesEnded, voiceScratch.voicesEnded );
+    }
+}
+
+const Explorer::AudioPlayback::PlayheadStates& Explorer::AudioPlayback::GetPlayheadStates ( )
+{
+    mPlayheadStates.Update ( );
+
+    return mPlayheadStates.Read ( );
 }
 
-std::vector<Utilities::VisualPlayhead> Explorer::AudioPlayback::GetPlayheadInfo ( )
+void Explorer::AudioPlayback::PublishPlayheadStates ( )
 {
-    std::lock_guard<std::mutex> lock ( mVisualPlayheadUpdateMutex );
+    PlayheadStates& states = mPlayheadStates.Write ( );
 
-    return mVisualPlayheads;
+    states.count = std::min ( mPlayheads.size ( ), (size_t)DEFAULT_MAX_PLAYHEADS );
+    for ( size_t i = 0; i < states.count; i++ )
+    {
+        states.playheads[i].playheadID = mPlayheads[i].playheadID;
+        states.playheads[i].fileIndex = mPlayheads[i].fileIndex;
+        states.playheads[i].sampleIndex = mPlayheads[i].sampleIndex;
+    }
+
+    mPlayheadStates.Publish ( );
 }
 
 void Explorer::AudioPlayback::SetFlagMissingOutput ( bool missing )
@@ -588,42 +1104,122 @@ void Explorer::AudioPlayback::WaitForMissingOutputConfirm ( )
 
 void Explorer::AudioPlayback::SetDimensionBounds ( const Utilities::DimensionBoundsData& dimensionBoundsData )
 {
-    if ( bStreamStarted )
+    // the audio thread keeps reading the bounds it had until it next looks, the old ones are freed here once it has moved on
+    mDimensionBounds.Publish ( std::make_unique<Utilities::DimensionBoundsData> ( dimensionBoundsData ) );
+}
+
+bool Explorer::AudioPlayback::TriggerPointsRemain ( const Utilities::AudioPlayhead& playhead )
+{
+    return playhead.sampleIndex + 1 < mRawView->GetAudioData ( )->length[playhead.fileIndex];
+}
+
+size_t Explorer::AudioPlayback::NextTriggerPoint ( const Utilities::AudioPlayhead& playhead )
+{
+    size_t hopSize = mRawView->GetHopSize ( );
+    size_t finalTrigger = mRawView->GetAudioData ( )->length[playhead.fileIndex] - 1;
+
+    return std::max ( std::min ( ( playhead.sampleIndex / hopSize + 1 ) * hopSize, finalTrigger ), playhead.sampleIndex );
+}
+
+size_t Explorer::AudioPlayback::TriggerPointsFrom ( const Utilities::AudioPlayhead& playhead )
+{
+    size_t hopSize = mRawView->GetHopSize ( );
+    size_t length = mRawView->GetAudioData ( )->length[playhead.fileIndex];
+    if ( playhead.sampleIndex >= length ) { return 0; }
+
+    // hop multiples in [ sampleIndex, length ), plus the final sample
+    return ( length + hopSize - 1 ) / hopSize - ( playhead.sampleIndex + hopSize - 1 ) / hopSize + 1;
+}
+
+template <typename SampleType>
+const SampleType* Explorer::AudioPlayback::GetSourceSamples ( size_t fileIndex, size_t sampleIndex, int streamSlot, const float* cachedSamples, size_t* frames, float* scratch )
+{
+    if constexpr ( std::is_same_v<SampleType, int16_t> )
     {
-        ofLogError ( "AudioPlayback" ) << "Attempted to set dimension bounds while audio stream is active, this should never happen, as it could hang the audio thread.";
+        return mRawView->GetAudioData ( )->rawInt16[fileIndex].data ( ) + sampleIndex; // compact storage is always resident
     }
+    else
+    {
+        if ( cachedSamples != nullptr )
+        {
+            return cachedSamples + sampleIndex;
+        }
 
-    std::lock_guard<std::mutex> lock ( mDimensionBoundsMutex );
+        if ( streamSlot < 0 )
+        {
+            return mRawView->GetAudioData ( )->raw[fileIndex].getBuffer ( ).data ( ) + sampleIndex; // might have to change if stereo input support is added
+        }
+
+        *frames = std::min ( *frames, mStreamer.Available ( streamSlot ) );
+        if ( *frames > 0 ) { mStreamer.Pull ( streamSlot, scratch, *frames ); }
+
+        return scratch;
+    }
+}
+
+bool Explorer::AudioPlayback::AttachStreamSlots ( Utilities::AudioPlayhead& playhead )
+{
+    playhead.streamSlot = mStreamer.AcquireSlot ( );
+    playhead.jumpStreamSlot = mStreamer.AcquireSlot ( );
+
+    if ( playhead.streamSlot < 0 || playhead.jumpStreamSlot < 0 )
+    {
+        ReleasePlayheadSources ( playhead );
+        return false;
+    }
 
-    mDimensionBounds = dimensionBoundsData;
+    mStreamer.Request ( playhead.streamSlot, playhead.fileIndex, playhead.sampleIndex );
+    return true;
 }
 
-// TODO - change mTimeCorpus from an ofMesh to a more efficient data structure
-void Explorer::AudioPlayback::SetCorpusMesh ( const std::vector<ofMesh>& corpusMesh )
+void Explorer::AudioPlayback::ReleasePlayheadSources ( Utilities::AudioPlayhead& playhead )
 {
-    std::lock_guard<std::mutex> lock ( mCorpusMeshMutex );
+    if ( playhead.streamSlot >= 0 ) { mStreamer.ReleaseSlot ( playhead.streamSlot ); }
+    if ( playhead.jumpStreamSlot >= 0 ) { mStreamer.ReleaseSlot ( playhead.jumpStreamSlot ); }
+
+    playhead.streamSlot = -1;
+    playhead.jumpStreamSlot = -1;
+
+    AudioCache* cache = mRawView->GetAudioCache ( );
+    if ( cache != nullptr && playhead.cachedSamples != nullptr ) { cache->Unpin ( playhead.fileIndex ); }
+    if ( cache != nullptr && playhead.jumpCachedSamples != nullptr ) { cache->Unpin ( playhead.jumpFileIndex ); }
 
-    mCorpusMesh = corpusMesh;
+    playhead.cachedSamples = nullptr;
+    playhead.jumpCachedSamples = nullptr;
+
+    if ( playhead.planSlot >= 0 ) { mJumpPlanner.ReleaseSlot ( playhead.planSlot ); }
+    playhead.planSlot = -1;
 }
 
-void Explorer::AudioPlayback::CalculateTriggerPoints ( Utilities::AudioPlayhead& playhead )
+Explorer::JumpPlanner::Rules Explorer::AudioPlayback::GetJumpRules ( )
 {
-    while ( !playhead.triggerSamplePoints.empty ( ) )
+    JumpPlanner::Rules rules;
+    rules.maxDistanceSpaceX1000 = mMaxJumpDistanceSpaceX1000;
+    rules.maxTargets = mMaxJumpTargets;
+    rules.sameFileAllowed = mJumpSameFileAllowed;
+    rules.minTimeDiffSameFile = mJumpSameFileMinTimeDiff;
+    rules.remainingSamplesRequired = mGovernor.CrossfadeSampleLength ( mCrossfadeSampleLength );
+    return rules;
+}
+
+void Explorer::AudioPlayback::PlanJumpsAhead ( Utilities::AudioPlayhead& playhead, size_t fileIndex, size_t timePointIndex, const JumpPlanner::Rules& rules )
+{
+    if ( playhead.planSlot < 0 ) { return; }
+
+    // decisions are for points, so moving a little further along the same file keeps what was planned, anything else (a jump, a loop) starts over
+    if ( fileIndex != playhead.plannedFile || timePointIndex > playhead.plannedUntil || timePointIndex + DEFAULT_JUMP_PLANNER_LOOKAHEAD < playhead.plannedUntil )
     {
-        playhead.triggerSamplePoints.pop ( );
+        mJumpPlanner.Reset ( playhead.planSlot );
+        playhead.plannedFile = fileIndex;
+        playhead.plannedUntil = timePointIndex;
     }
 
-    int triggerPointDistance = mRawView->GetHopSize ( );
-    int currentTriggerPoint = 0;
+    size_t hopSize = mRawView->GetHopSize ( );
+    size_t fileLength = mRawView->GetAudioData ( )->length[fileIndex];
 
-    while ( currentTriggerPoint < mRawView->GetAudioData ( )->raw[playhead.fileIndex].size ( ) ) // might have to change if stereo input support is added
+    while ( playhead.plannedUntil < timePointIndex + DEFAULT_JUMP_PLANNER_LOOKAHEAD && ( playhead.plannedUntil + 1 ) * hopSize < fileLength )
     {
-        if ( currentTriggerPoint >= playhead.sampleIndex )
-        {
-            playhead.triggerSamplePoints.push ( currentTriggerPoint );
-        }
-        currentTriggerPoint += triggerPointDistance;
+        if ( !mJumpPlanner.Plan ( playhead.planSlot, fileIndex, playhead.plannedUntil + 1, rules ) ) { break; }
+        playhead.plannedUntil++;
     }
-
-    playhead.triggerSamplePoints.push ( mRawView->GetAudioData ( )->raw[playhead.fileIndex].size ( ) - 1 ); // might have to change if stereo input support is added
 }
\ No newline at end of file
@@ -18,42 +18,106 @@ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 
 #include "Explorer/RawView.h"
 #include "Explorer/PointPicker.h"
+#include "Explorer/AudioStreamer.h"
+#include "Explorer/JumpPlanner.h"
+#include "Explorer/QualityGovernor.h"
 #include "Utilities/Data.h"
 #include "Utilities/DimensionBounds.h"
+#include "Utilities/SPSCQueue.h"
+#include "Utilities/NoAllocationScope.h"
+#include "Utilities/RealtimeWorkerPool.h"
+#include "Utilities/Resampler.h"
+#include "Utilities/TripleBuffer.h"
+#include "Utilities/SharedSnapshot.h"
 
 #include <ofSoundBuffer.h>
 #include <ofSoundStream.h>
-#include <ofMesh.h>
 #include <random>
 #include <vector>
 #include <mutex>
 #include <atomic>
+#include <utility>
+#include <chrono>
 
 namespace Acorex {
 namespace Explorer {
 
 class AudioPlayback {
 public:
+    // every playhead as of the end of a buffer, in the order they were created
+    struct PlayheadStates {
+        size_t count = 0;
+        Utilities::PlayheadState playheads[DEFAULT_MAX_PLAYHEADS];
+    };
+
+    // why a jump chance that came up at a trigger point went untaken
+    enum JumpSkipCause : int {
+        PLANNER_BEHIND = 0, // no decision for this trigger yet, the planner thread hasn't caught up with the playhead
+        NO_PLAN_SLOT = 1, // every planner slot was taken when the playhead was created, so it never jumps
+        NO_TARGET = 2, // the planner searched but nothing met the jump rules
+        TARGET_NOT_RESIDENT = 3, // the target's file isn't loaded, or was evicted from the cache since the search
+        PREFETCH_LATE = 4, // streamed audio for the target hadn't arrived by the next trigger
+        JUMP_SKIP_CAUSES = 5
+    };
+    static const char* GetJumpSkipCauseName ( int cause );
+
+    // callbacks by time taken as a share of the time their buffer lasts, split at each of kLoadHistogramEdgesPercent
+    static constexpr int kLoadHistogramBuckets = 6;
+    static constexpr int kLoadHistogramEdgesPercent[kLoadHistogramBuckets - 1] = { 25, 50, 75, 90, 100 };
+
+    // counted by the audio thread since the stream last started, read from any thread without blocking it
+    struct Telemetry {
+        uint64_t callbacks = 0;
+        uint64_t loadHistogram[kLoadHistogramBuckets] = { };
+        float loadPercent = 0.0f; // smoothed over roughly the last half second
+        float peakLoadPercent = 0.0f; // the slowest callback in the last full second
+        uint64_t overruns = 0; // callbacks that took longer than their buffer lasts
+        uint64_t lateCallbacks = 0; // started over a buffer and a half after the one before, the device most likely ran dry in between
+
+        uint64_t jumpsTaken = 0;
+        uint64_t jumpsSkipped[JUMP_SKIP_CAUSES] = { };
+
+        uint64_t voicesEnded = 0; // reached the end of their file without looping
+        uint64_t voicesKilled = 0; // by a kill command
+        uint64_t voicesShed = 0; // faded out by the quality governor
+        uint64_t createsRefused = 0; // create commands that reached the audio thread with no voice or stream slots left for them
+        uint64_t commandsDropped = 0; // refused by CreatePlayhead, KillPlayhead or SetVolumeX1000 because the command queue was full
+
+        int qualityLevel = QualityGovernor::FULL_QUALITY;
+    };
+
     AudioPlayback ( );
     ~AudioPlayback ( ) { }
 
+    // sampleRate is the corpus rate, the device runs at it if it can, otherwise at a rate it supports with the mix converted to it
     bool StartRestartAudio ( size_t sampleRate, size_t bufferSize, ofSoundDevice outDevice );
     void ClearAndKillAudio ( );
+    void InitialiseStorage ( bool offline = false ); // starts jump planning, and disk streaming if the loaded corpus is not held in memory, call before starting audio
+
+    // offline rendering, with no device, the caller pulls buffers through RenderOffline as fast as it likes in place of the audio thread
+    // jumps are planned between buffers rather than on the planner thread, and each buffer waits for the audio its playheads need from disk
+    bool StartOffline ( size_t sampleRate, size_t bufferSize ); // after InitialiseStorage ( true ), buffers can be any size up to bufferSize
+    void RenderOffline ( ofSoundBuffer& outBuffer );
+    void SetRandomSeed ( uint32_t seed ) { mRandomGen.seed ( seed ); } // audio must not be running, every playhead created after is seeded from this
 
     void audioOut ( ofSoundBuffer& outBuffer );
 
     void SetRawView ( std::shared_ptr<RawView>& rawPointer ) { mRawView = rawPointer; }
 
-    bool CreatePlayhead ( size_t fileIndex, size_t timePointIndex );
-    bool KillPlayhead ( size_t playheadID );
-    std::vector<Utilities::VisualPlayhead> GetPlayheadInfo ( );
+    // commands reach the audio thread through a fixed size queue, and are applied in the order they were sent
+    // atSample is a time on GetSampleTime's clock to apply them at, 0 for the next buffer, a command not yet due holds back those sent after it
+    // when the queue is nearly full new playheads are refused, kills and parameter changes only fail if it is completely full, either way the caller gets false
+    bool CreatePlayhead ( size_t fileIndex, size_t timePointIndex, uint64_t atSample = 0 );
+    bool KillPlayhead ( size_t playheadID, uint64_t atSample = 0 );
+    uint64_t GetSampleTime ( ) const { return mSampleTime; } // frames rendered at the corpus rate since the stream started, the start of the next buffer
+    // one reader thread only (the UI), the states stay as they are until its next call, never blocks the audio thread or is blocked by it
+    const PlayheadStates& GetPlayheadStates ( );
     void SetFlagMissingOutput ( bool missing );
     void WaitForMissingOutputConfirm ( );
 
     void UserInvokedPause ( bool pause ) { bUserPauseFlag = pause; }
 
-    void SetDimensionBounds ( const Utilities::DimensionBoundsData& dimensionBoundsData );
-    void SetCorpusMesh ( const std::vector<ofMesh>& corpusMesh );
+    void SetDimensionBounds ( const Utilities::DimensionBoundsData& dimensionBoundsData ); // any thread, the audio thread picks them up at its next buffer
 
     void SetPointPicker ( std::shared_ptr<PointPicker>& pointPicker ) { mPointPicker = pointPicker; }
 
@@ -64,15 +128,97 @@ public:
     void SetCrossfadeSampleLength ( int length ) { mCrossfadeSampleLength = length; }
     void SetMaxJumpDistanceSpace ( int distanceX1000 ) { mMaxJumpDistanceSpaceX1000 = distanceX1000; }
     void SetMaxJumpTargets ( int targets ) { mMaxJumpTargets = targets; }
-    void SetVolumeX1000 (int volumeX1000) { mVolumeX1000 = volumeX1000; }
+    bool SetVolumeX1000 ( int volumeX1000, uint64_t atSample = 0 );
     void SetDynamicPan ( bool enabled, int dimensionIndex ) { mDynamicPanEnabled = false; mDynamicPanDimensionIndex = dimensionIndex; mDynamicPanEnabled = enabled; }
     void SetPanningStrengthX1000 ( int panStrengthX1000 ) { mPanningStrengthX1000 = panStrengthX1000; }
 
-private:
-    void FillAudioSegment ( ofSoundBuffer* outBuffer, size_t* outBufferPosition, Utilities::AudioPlayhead* playhead, bool outBufferFull );
-    void CrossfadeAudioSegment ( ofSoundBuffer* outBuffer, size_t* outBufferPosition, Utilities::AudioPlayhead* playhead, bool outBufferFull );
+    Telemetry GetTelemetry ( ) const;
 
-    void CalculateTriggerPoints ( Utilities::AudioPlayhead& playhead );
+    // under CPU pressure the governor shortens crossfades, narrows the jump search, updates visual playheads less often, then sheds the oldest playheads
+    // it never acts while rendering offline, where there is no deadline to miss
+    void SetGovernorPolicy ( const QualityGovernor::Policy& policy ) { mGovernor.SetPolicy ( policy ); }
+    QualityGovernor::Policy GetGovernorPolicy ( ) { return mGovernor.GetPolicy ( ); }
+
+private:
+    // what every playhead renders with this buffer, read once by the audio thread so the voices can be rendered on any thread
+    struct VoiceRenderContext {
+        bool streamed = false;
+        bool compact = false;
+        AudioCache* cache = nullptr;
+
+        bool loopPlayheads = false;
+        int crossfadeSampleLength = 0; // as the governor allows
+        int crossoverJumpChanceX1000 = 0;
+        JumpPlanner::Rules jumpRules;
+
+        float panningStrength = 0.0f; // 0 with dynamic pan off
+        int panDimensionIndex = 0;
+        double panMin = 0.0;
+        double panMax = 1.0;
+    };
+
+    // one per thread that can render voices, sized to the buffer size when the stream starts
+    struct VoiceScratch {
+        std::vector<float> stream[2]; // [current, jump]
+
+        // counted here by whichever thread renders, then added to the telemetry by the audio thread once every voice is done
+        uint64_t jumpsTaken = 0;
+        uint64_t jumpsSkipped[JUMP_SKIP_CAUSES] = { };
+        uint64_t voicesEnded = 0;
+    };
+
+    // renders one playhead into its voice buffer, touching nothing shared with other playheads, so any number can run at once
+    // a playhead that ends or is killed is faded out and marked killed, its sources are released afterwards by the audio thread
+    void RenderVoice ( Utilities::AudioPlayhead& playhead, ofSoundBuffer& playheadBuffer, const VoiceRenderContext& context, VoiceScratch& scratch );
+
+    // SampleType is float, or int16_t for compact resident storage, converted to float as it is mixed
+    template <typename SampleType>
+    bool FillAudioSegment ( ofSoundBuffer* outBuffer, size_t* outBufferPosition, Utilities::AudioPlayhead* playhead, bool outBufferFull,
+                            const VoiceRenderContext& context, VoiceScratch& scratch ); // returns false if streamed audio ran short
+    template <typename SampleType>
+    void CrossfadeAudioSegment ( ofSoundBuffer* outBuffer, size_t* outBufferPosition, Utilities::AudioPlayhead* playhead, bool outBufferFull,
+                                 const VoiceRenderContext& context, VoiceScratch& scratch );
+
+    // trigger points are every hop through the file, then its final sample, worked out from the playhead's position rather than stored
+    bool TriggerPointsRemain ( const Utilities::AudioPlayhead& playhead );
+    size_t NextTriggerPoint ( const Utilities::AudioPlayhead& playhead ); // the first after sampleIndex while TriggerPointsRemain, never before it
+    size_t TriggerPointsFrom ( const Utilities::AudioPlayhead& playhead ); // how many there are at or after sampleIndex
+
+    bool IsStreamed ( ) { return mRawView->GetAudioData ( )->storageMode == Utilities::AudioStorageMode::STREAMED; }
+    template <typename SampleType>
+    const SampleType* GetSourceSamples ( size_t fileIndex, size_t sampleIndex, int streamSlot, const float* cachedSamples, size_t* frames, float* scratch ); // frames is reduced to what is available
+    bool AttachStreamSlots ( Utilities::AudioPlayhead& playhead );
+    void ReleasePlayheadSources ( Utilities::AudioPlayhead& playhead ); // stream slots, cache pins and plan slot
+    void PlanJumpsAhead ( Utilities::AudioPlayhead& playhead, size_t fileIndex, size_t timePointIndex, const JumpPlanner::Rules& rules ); // starts a new plan if the playhead is not where the last one expected
+
+    struct PlayheadCommand {
+        enum class Type { Create, Kill, SetVolume };
+
+        Type type = Type::Create;
+        uint64_t atSample = 0;
+        size_t playheadID = 0;
+        size_t fileIndex = 0; // create only
+        size_t sampleIndex = 0; // create only
+        int volumeX1000 = 0; // set volume only
+    };
+
+    static size_t ChooseDeviceSampleRate ( size_t corpusSampleRate, const ofSoundDevice& outDevice );
+    void AllocateVoices ( size_t sampleRate, size_t bufferSize, size_t deviceSampleRate ); // mKillAudioOnlyAudioThreadBlockingMutex must be held
+
+    void RenderMix ( ofSoundBuffer& mixBuffer, bool audioProcessingBlocked ); // every playhead, at the corpus rate, for as many frames as mixBuffer has
+    void RenderResampled ( ofSoundBuffer& outBuffer, bool audioProcessingBlocked ); // RenderMix through the output resamplers, for a device at another rate
+    bool OfflineSourcesReady ( size_t frames ); // whether every playhead's streamed audio for the next frames has arrived, or its file has been cached
+
+    bool SendCommand ( const PlayheadCommand& command, size_t placesToLeave ); // mCommandSendMutex must be held
+    void ApplyCommands ( size_t bufferFrames, bool audioProcessingBlocked, bool streamed, AudioCache* cache, const JumpPlanner::Rules& jumpRules );
+    JumpPlanner::Rules GetJumpRules ( ); // audio thread only, the jump settings for this buffer as the governor allows
+    void ApplyVolume ( ofSoundBuffer& outBuffer ); // the global volume, changing at each of this buffer's volume changes
+
+    void ResetTelemetry ( ); // mKillAudioOnlyAudioThreadBlockingMutex must be held
+    float RecordCallbackTime ( std::chrono::steady_clock::time_point callbackStart, size_t frames, size_t sampleRate ); // audio thread only, at the end of each callback, returns its load
+    void PublishPlayheadStates ( ); // audio thread only, or with mKillAudioOnlyAudioThreadBlockingMutex held
+    void ShedVoices ( size_t count ); // audio thread only, fades out the oldest playheads not already on their way out
+    void GatherVoiceTelemetry ( ); // audio thread only, after every voice has rendered
 
     std::shared_ptr<RawView> mRawView;
     std::shared_ptr<PointPicker> mPointPicker;
@@ -104,24 +250,78 @@ private:
 
     // playhead states ---------------------------
 
-    std::vector<Utilities::AudioPlayhead> mPlayheads;
+    std::vector<Utilities::AudioPlayhead> mPlayheads; // capacity is the voice pool, DEFAULT_MAX_PLAYHEADS, it never grows past it
+    std::vector<ofSoundBuffer> mVoiceBuffers; // scratch for each of mPlayheads, allocated for the buffer size when the stream starts
     std::atomic<int> mActivePlayheads;
 
-    std::mutex mNewPlayheadMutex;
-    std::queue<Utilities::AudioPlayhead> mNewPlayheads;
-    std::queue<size_t> mPlayheadsToKill;
+    Utilities::SPSCQueue<PlayheadCommand> mCommands; // control threads to audio thread
+    std::mutex mCommandSendMutex; // only ever between control threads, so they take turns as the queue's one producer, never taken by the audio thread
     size_t playheadCounter;
+    std::atomic<uint64_t> mSampleTime;
+
+    // audio thread only
+    double mVolume;
+    static constexpr size_t kMaxVolumeChangesPerBuffer = 8; // any more replace the last
+    std::pair<size_t, double> mVolumeChanges[kMaxVolumeChangesPerBuffer]; // offset into the buffer, volume from there
+    size_t mVolumeChangeCount;
+
+    // written by the audio thread, or by whichever thread holds mKillAudioOnlyAudioThreadBlockingMutex while it isn't running
+    Utilities::TripleBuffer<PlayheadStates> mPlayheadStates;
+
+    // shared with the audio thread ---------------
+
+    Utilities::SharedSnapshot<Utilities::DimensionBoundsData> mDimensionBounds; // read without locking by the audio thread, for dynamic panning
+
+    // output sample rate conversion -------------
+
+    // one per channel, passthrough while the device runs at the corpus rate, everything below is audio thread only once the stream starts
+    Utilities::Resampler mOutputResampler[2];
+    ofSoundBuffer mMixBuffer; // at the corpus rate
+    size_t mMixCapacityFrames;
+    std::vector<float> mResampleIn[2];
+    std::vector<float> mResampleOut[2];
+    std::vector<float> mResampled; // interleaved, at the device rate, converted but not yet output
+    size_t mResampledFrames;
+
+    // disk streaming ------------------------------
+
+    AudioStreamer mStreamer;
+
+    // jump planning -------------------------------
+
+    JumpPlanner mJumpPlanner;
+
+    // quality governor ----------------------------
+
+    QualityGovernor mGovernor;
+
+    // voice rendering -----------------------------
 
-    std::mutex mVisualPlayheadUpdateMutex;
-    std::vector<Utilities::VisualPlayhead> mVisualPlayheads;
+    Utilities::RealtimeWorkerPool mRenderPool; // DEFAULT_VOICE_RENDER_WORKERS threads, started with the stream
+    std::vector<VoiceScratch> mVoiceScratch; // [0] for the audio thread, then one per worker
 
-    // audio thread local copies ------------------
+    // telemetry -----------------------------------
 
-    std::mutex mDimensionBoundsMutex;
-    Utilities::DimensionBoundsData mDimensionBounds;
+    // relaxed atomics written by the audio thread (mCommandsDropped by control threads), so reading them never holds it up
+    std::atomic<uint64_t> mCallbacks;
+    std::atomic<uint64_t> mLoadHistogram[kLoadHistogramBuckets];
+    std::atomic<float> mLoadPercent;
+    std::atomic<float> mPeakLoadPercent;
+    std::atomic<uint64_t> mOverruns;
+    std::atomic<uint64_t> mLateCallbacks;
+    std::atomic<uint64_t> mJumpsTaken;
+    std::atomic<uint64_t> mJumpsSkipped[JUMP_SKIP_CAUSES];
+    std::atomic<uint64_t> mVoicesEnded;
+    std::atomic<uint64_t> mVoicesKilled;
+    std::atomic<uint64_t> mVoicesShed;
+    std::atomic<uint64_t> mCreatesRefused;
+    std::atomic<uint64_t> mCommandsDropped;
 
-    std::mutex mCorpusMeshMutex;
-    std::vector<ofMesh> mCorpusMesh;
+    // audio thread only
+    bool bOffline; // set with the stream, callbacks then come as fast as the renderer asks so none are ever late
+    std::chrono::steady_clock::time_point mLastCallbackStart;
+    double mPeakWindowSeconds; // how much audio the current peak load window has covered
+    float mPeakWindowLoadPercent;
 
     // settings -----------------------------------
 
@@ -132,14 +332,13 @@ private:
     std::atomic<int> mCrossfadeSampleLength;
     std::atomic<int> mMaxJumpDistanceSpaceX1000;
     std::atomic<int> mMaxJumpTargets;
-    std::atomic<int> mVolumeX1000;
     std::atomic<bool> mDynamicPanEnabled;
     std::atomic<int> mDynamicPanDimensionIndex;
     std::atomic<int> mPanningStrengthX1000;
 
     // Randomness ---------------------------------
 
-    std::mt19937 mRandomGen;
+    std::mt19937 mRandomGen; // audio thread only, seeds each new playhead's own generator
 };
 
 } // namespace Explorer
@@ -0,0 +1,253 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Explorer/AudioStreamer.h"
+
+#include <ofLog.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace Acorex;
+
+Explorer::AudioStreamer::AudioStreamer ( ) : mSampleRate ( DEFAULT_ANALYSE_SAMPLE_RATE ), bRunning ( false )
+{
+}
+
+void Explorer::AudioStreamer::Initialise ( const Utilities::DataSet& dataset, size_t maxPlayheads )
+{
+    Stop ( );
+
+    mFileList = dataset.fileList;
+    mSampleRate = dataset.analysisSettings.sampleRate;
+
+    size_t slotCount = maxPlayheads * 2;
+    mFreeSlots.reserve ( slotCount );
+
+    for ( size_t i = 0; i < slotCount; i++ )
+    {
+        mSlots.push_back ( std::make_unique<StreamSlot> ( ) );
+        mSlots.back ( )->ring.resize ( DEFAULT_STREAM_RING_FRAMES, 0.0f );
+        mSlots.back ( )->ringMask = DEFAULT_STREAM_RING_FRAMES - 1;
+    }
+
+    for ( int i = (int)slotCount - 1; i >= 0; i-- )
+    {
+        mFreeSlots.push_back ( i );
+    }
+
+    bRunning = true;
+    mIOThread = std::thread ( &AudioStreamer::IOThreadLoop, this );
+}
+
+void Explorer::AudioStreamer::Stop ( )
+{
+    bRunning = false;
+    if ( mIOThread.joinable ( ) ) { mIOThread.join ( ); }
+
+    mSlots.clear ( );
+    mFreeSlots.clear ( );
+    mFileList.clear ( );
+}
+
+int Explorer::AudioStreamer::AcquireSlot ( )
+{
+    if ( mFreeSlots.empty ( ) ) { return -1; }
+
+    int slot = mFreeSlots.back ( );
+    mFreeSlots.pop_back ( );
+    mSlots[slot]->inUse = true;
+
+    return slot;
+}
+
+void Explorer::AudioStreamer::ReleaseSlot ( int slot )
+{
+    if ( slot < 0 || !mSlots[slot]->inUse ) { return; }
+
+    Cancel ( slot );
+    mSlots[slot]->inUse = false;
+    mFreeSlots.push_back ( slot ); // capacity reserved in Initialise, never allocates
+}
+
+void Explorer::AudioStreamer::Request ( int slot, size_t fileIndex, size_t sampleIndex )
+{
+    StreamSlot& stream = *mSlots[slot];
+
+    // everything written before the generation is published is visible to the I/O thread once it sees the new generation
+    stream.readPosition.store ( 0, std::memory_order_relaxed );
+    stream.requestFile.store ( fileIndex, std::memory_order_relaxed );
+    stream.requestSample.store ( sampleIndex, std::memory_order_relaxed );
+    stream.generation++;
+    stream.requestGeneration.store ( stream.generation, std::memory_order_release );
+}
+
+void Explorer::AudioStreamer::Cancel ( int slot )
+{
+    Request ( slot, kIdleFile, 0 );
+}
+
+size_t Explorer::AudioStreamer::Available ( int slot ) const
+{
+    const StreamSlot& stream = *mSlots[slot];
+
+    if ( stream.readyGeneration.load ( std::memory_order_acquire ) != stream.generation ) { return 0; }
+    if ( stream.endGeneration.load ( std::memory_order_acquire ) == stream.generation ) { return std::numeric_limits<size_t>::max ( ); }
+
+    return (size_t)(stream.writePosition.load ( std::memory_order_acquire ) - stream.readPosition.load ( std::memory_order_relaxed ));
+}
+
+size_t Explorer::AudioStreamer::Pull ( int slot, float* output, size_t frames )
+{
+    StreamSlot& stream = *mSlots[slot];
+
+    if ( stream.readyGeneration.load ( std::memory_order_acquire ) != stream.generation ) { return 0; }
+
+    // end flag must be read before the write position, so a final write position is never missed
+    bool ended = stream.endGeneration.load ( std::memory_order_acquire ) == stream.generation;
+    uint64_t readPosition = stream.readPosition.load ( std::memory_order_relaxed );
+    size_t available = (size_t)(stream.writePosition.load ( std::memory_order_acquire ) - readPosition);
+    size_t count = std::min ( frames, available );
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+        output[i] = stream.ring[(readPosition + i) & stream.ringMask];
+    }
+
+    stream.readPosition.store ( readPosition + count, std::memory_order_release );
+
+    if ( !ended ) { return count; }
+
+    std::fill ( output + count, output + frames, 0.0f );
+    return frames;
+}
+
+void Explorer::AudioStreamer::IOThreadLoop ( )
+{
+    while ( bRunning )
+    {
+        bool didWork = false;
+
+        for ( auto& slot : mSlots )
+        {
+            if ( ServiceSlot ( *slot ) ) { didWork = true; }
+        }
+
+        if ( !didWork ) { std::this_thread::sleep_for ( std::chrono::milliseconds ( 1 ) ); }
+    }
+}
+
+bool Explorer::AudioStreamer::ServiceSlot ( StreamSlot& slot )
+{
+    uint32_t generation = slot.requestGeneration.load ( std::memory_order_acquire );
+    if ( generation != slot.servicedGeneration )
+    {
+        StartRequest ( slot, generation );
+        return true;
+    }
+
+    if ( slot.finished ) { return false; }
+
+    // a read position ahead of what was written (or a fresh zero) belongs to a newer request, picked up on the next pass
+    uint64_t readPosition = slot.readPosition.load ( std::memory_order_acquire );
+    if ( readPosition > slot.written || slot.written - readPosition > slot.ring.size ( ) ) { return false; }
+
+    size_t chunkFrames = DEFAULT_STREAM_DECODE_CHUNK_FRAMES;
+    size_t space = slot.ring.size ( ) - (size_t)(slot.written - readPosition);
+    if ( space < slot.resampleBuffer.size ( ) ) { return false; }
+
+    size_t framesRead = slot.file.ReadMono ( slot.monoBuffer.data ( ), chunkFrames );
+
+    const float* output = slot.monoBuffer.data ( );
+    size_t produced = framesRead;
+    if ( !slot.resampler.IsPassthrough ( ) )
+    {
+        produced = slot.resampler.ProcessChunk ( slot.monoBuffer.data ( ), framesRead, slot.resampleBuffer.data ( ) );
+        if ( framesRead < chunkFrames ) { produced += slot.resampler.Flush ( slot.resampleBuffer.data ( ) + produced ); }
+        output = slot.resampleBuffer.data ( );
+    }
+
+    for ( size_t i = 0; i < produced; i++ )
+    {
+        slot.ring[(slot.written + i) & slot.ringMask] = output[i];
+    }
+
+    slot.written += produced;
+    slot.writePosition.store ( slot.written, std::memory_order_release );
+
+    if ( framesRead < chunkFrames )
+    {
+        slot.finished = true;
+        slot.endGeneration.store ( generation, std::memory_order_release );
+    }
+
+    slot.readyGeneration.store ( generation, std::memory_order_release );
+
+    return true;
+}
+
+void Explorer::AudioStreamer::StartRequest ( StreamSlot& slot, uint32_t generation )
+{
+    slot.servicedGeneration = generation;
+    slot.finished = true;
+    slot.written = 0;
+    slot.writePosition.store ( 0, std::memory_order_relaxed );
+
+    size_t fileIndex = slot.requestFile.load ( std::memory_order_relaxed );
+    size_t sampleIndex = slot.requestSample.load ( std::memory_order_relaxed );
+
+    if ( fileIndex == kIdleFile ) { return; } // decoder is kept open, the same file is likely to be requested again
+
+    bool success = fileIndex < mFileList.size ( );
+
+    if ( success && slot.openFile != fileIndex )
+    {
+        slot.openFile = kIdleFile;
+        success = slot.file.Open ( mFileList[fileIndex] );
+        if ( success ) { slot.openFile = fileIndex; }
+    }
+
+    double sourcePosition = 0.0;
+    uint64_t seekFrame = 0;
+    if ( success )
+    {
+        // start decoding early enough to fill the filter window around the first output frame
+        slot.resampler.Initialise ( slot.file.GetSampleRate ( ), mSampleRate );
+        sourcePosition = (double)sampleIndex * slot.resampler.GetStep ( );
+        uint64_t sourceFrame = (uint64_t)sourcePosition;
+        uint64_t latency = slot.resampler.GetLatency ( );
+        seekFrame = sourceFrame > latency ? sourceFrame - latency : 0;
+        success = slot.file.Seek ( seekFrame );
+    }
+
+    if ( !success )
+    {
+        // publish an empty, finished stream so the playhead plays silence instead of stalling forever
+        ofLogError ( "AudioStreamer" ) << "Failed to stream file index " << fileIndex << " from sample " << sampleIndex;
+        slot.endGeneration.store ( generation, std::memory_order_release );
+        slot.readyGeneration.store ( generation, std::memory_order_release );
+        return;
+    }
+
+    slot.resampler.Reset ( sourcePosition - (double)seekFrame );
+
+    size_t chunkFrames = DEFAULT_STREAM_DECODE_CHUNK_FRAMES;
+    slot.monoBuffer.resize ( chunkFrames );
+    slot.resampleBuffer.resize ( slot.resampler.GetMaxOutputFrames ( chunkFrames ) + slot.resampler.GetMaxOutputFrames ( slot.resampler.GetLatency ( ) ) );
+
+    slot.finished = false;
+}
@@ -0,0 +1,109 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Utilities/Data.h"
+#include "Utilities/AudioFileStream.h"
+#include "Utilities/Resampler.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <limits>
+
+namespace Acorex {
+namespace Explorer {
+
+// streams corpus audio from disk for playback when files are not held in memory
+// every playhead owns two slots, one following its current position and one prefetching its pending jump target
+// slots are allocated and requested only by the audio thread, a single I/O thread decodes ahead into each slot's ring buffer
+// the audio thread never waits on the I/O thread, if a slot has not caught up it simply reports fewer frames available
+class AudioStreamer {
+public:
+    AudioStreamer ( );
+    ~AudioStreamer ( ) { Stop ( ); }
+
+    void Initialise ( const Utilities::DataSet& dataset, size_t maxPlayheads ); // audio stream must not be running
+    void Stop ( );
+
+    bool IsRunning ( ) const { return bRunning; }
+    size_t GetMaxPlayheads ( ) const { return mSlots.size ( ) / 2; }
+
+    // audio thread only -------------------------
+
+    int AcquireSlot ( ); // returns -1 if no slot is free
+    void ReleaseSlot ( int slot );
+
+    void Request ( int slot, size_t fileIndex, size_t sampleIndex ); // discards anything buffered and starts decoding from the new position
+    void Cancel ( int slot ); // discards anything buffered and leaves the slot idle
+
+    size_t Available ( int slot ) const; // frames that can be pulled without underrunning, unbounded once the end of file has been decoded
+    size_t Pull ( int slot, float* output, size_t frames ); // returns frames pulled, output is zero padded past the end of the file
+
+private:
+    static constexpr size_t kIdleFile = std::numeric_limits<size_t>::max ( );
+
+    struct StreamSlot {
+        // mono at the corpus sample rate, positions are in frames since the current request and only ever increase
+        std::vector<float> ring;
+        size_t ringMask = 0;
+
+        // written by the audio thread
+        std::atomic<uint32_t> requestGeneration { 0 };
+        std::atomic<size_t> requestFile { kIdleFile };
+        std::atomic<size_t> requestSample { 0 };
+        std::atomic<uint64_t> readPosition { 0 };
+
+        // written by the I/O thread
+        std::atomic<uint32_t> readyGeneration { 0 };
+        std::atomic<uint32_t> endGeneration { 0 };
+        std::atomic<uint64_t> writePosition { 0 };
+
+        // audio thread only
+        uint32_t generation = 0;
+        bool inUse = false;
+
+        // I/O thread only
+        uint32_t servicedGeneration = 0;
+        bool finished = true;
+        uint64_t written = 0;
+        size_t openFile = kIdleFile;
+        Utilities::AudioFileStream file;
+        Utilities::Resampler resampler;
+        std::vector<float> monoBuffer;
+        std::vector<float> resampleBuffer;
+    };
+
+    void IOThreadLoop ( );
+    bool ServiceSlot ( StreamSlot& slot ); // returns true if any work was done
+    void StartRequest ( StreamSlot& slot, uint32_t generation );
+
+    std::vector<std::unique_ptr<StreamSlot>> mSlots;
+    std::vector<int> mFreeSlots;
+
+    std::vector<std::string> mFileList;
+    double mSampleRate;
+
+    std::thread mIOThread;
+    std::atomic<bool> bRunning;
+};
+
+} // namespace Explorer
+} // namespace Acorex
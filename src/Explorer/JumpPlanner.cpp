@@ -0,0 +1,206 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Explorer/JumpPlanner.h"
+
+#include <chrono>
+
+using namespace Acorex;
+
+Explorer::JumpPlanner::JumpPlanner ( ) : bRunning ( false )
+{
+}
+
+void Explorer::JumpPlanner::Initialise ( const std::shared_ptr<PointPicker>& pointPicker, const std::shared_ptr<RawView>& rawView, size_t maxPlayheads, bool plannerThread )
+{
+    Stop ( );
+
+    mPointPicker = pointPicker;
+    mRawView = rawView;
+
+    mFreeSlots.reserve ( maxPlayheads );
+
+    for ( size_t i = 0; i < maxPlayheads; i++ )
+    {
+        mSlots.push_back ( std::make_unique<PlanSlot> ( ) );
+        mSlots.back ( )->requests.Reserve ( DEFAULT_JUMP_PLANNER_QUEUE_SIZE );
+        mSlots.back ( )->decisions.Reserve ( DEFAULT_JUMP_PLANNER_QUEUE_SIZE );
+    }
+
+    for ( int i = (int)maxPlayheads - 1; i >= 0; i-- )
+    {
+        mFreeSlots.push_back ( i );
+    }
+
+    // at most every slot's full decision queue in one batch
+    size_t maxBatch = maxPlayheads * ( mSlots.empty ( ) ? 0 : mSlots.front ( )->decisions.Capacity ( ) );
+    mBatchSlots.reserve ( maxBatch );
+    mBatchRequests.reserve ( maxBatch );
+    mBatchQueries.reserve ( maxBatch );
+    mBatchTargets.resize ( maxBatch );
+    mBatchFound = std::make_unique<bool[]> ( maxBatch );
+
+    bRunning = true;
+    if ( plannerThread ) { mPlannerThread = std::thread ( &JumpPlanner::PlannerThreadLoop, this ); }
+}
+
+void Explorer::JumpPlanner::Stop ( )
+{
+    bRunning = false;
+    if ( mPlannerThread.joinable ( ) ) { mPlannerThread.join ( ); }
+
+    mSlots.clear ( );
+    mFreeSlots.clear ( );
+    mBatchFound.reset ( );
+    mPointPicker.reset ( );
+    mRawView.reset ( );
+}
+
+void Explorer::JumpPlanner::PlanNow ( )
+{
+    if ( !bRunning || mPlannerThread.joinable ( ) ) { return; }
+
+    while ( GatherRequests ( ) ) { AnswerRequests ( ); }
+}
+
+int Explorer::JumpPlanner::AcquireSlot ( )
+{
+    if ( mFreeSlots.empty ( ) ) { return -1; }
+
+    int slot = mFreeSlots.back ( );
+    mFreeSlots.pop_back ( );
+    mSlots[slot]->inUse = true;
+    Reset ( slot ); // whatever the previous owner left queued is stale
+
+    return slot;
+}
+
+void Explorer::JumpPlanner::ReleaseSlot ( int slot )
+{
+    if ( slot < 0 || !mSlots[slot]->inUse ) { return; }
+
+    Reset ( slot );
+    mSlots[slot]->inUse = false;
+    mFreeSlots.push_back ( slot ); // capacity reserved in Initialise, never allocates
+}
+
+bool Explorer::JumpPlanner::Plan ( int slot, size_t fileIndex, size_t timePointIndex, const Rules& rules )
+{
+    Request request;
+    request.generation = mSlots[slot]->generation;
+    request.point.file = fileIndex;
+    request.point.time = timePointIndex;
+    request.rules = rules;
+
+    return mSlots[slot]->requests.Push ( request );
+}
+
+void Explorer::JumpPlanner::Reset ( int slot )
+{
+    // requests still queued are answered, but their decisions carry the old generation and are dropped on arrival
+    mSlots[slot]->generation++;
+}
+
+Explorer::JumpPlanner::DecisionResult Explorer::JumpPlanner::TakeDecision ( int slot, size_t fileIndex, size_t timePointIndex, Utilities::PointFT& target )
+{
+    PlanSlot& planSlot = *mSlots[slot];
+
+    while ( const Decision* decision = planSlot.decisions.Peek ( ) )
+    {
+        if ( decision->generation != planSlot.generation || decision->point.file != fileIndex || decision->point.time < timePointIndex )
+        {
+            planSlot.decisions.Drop ( );
+            continue;
+        }
+
+        if ( decision->point.time > timePointIndex ) { return DecisionResult::NOT_READY; } // planned for a later trigger, this one was missed
+
+        bool found = decision->found;
+        target = decision->target;
+        planSlot.decisions.Drop ( );
+        return found ? DecisionResult::TARGET : DecisionResult::NO_TARGET;
+    }
+
+    return DecisionResult::NOT_READY;
+}
+
+void Explorer::JumpPlanner::PlannerThreadLoop ( )
+{
+    while ( bRunning )
+    {
+        if ( !GatherRequests ( ) )
+        {
+            std::this_thread::sleep_for ( std::chrono::milliseconds ( 1 ) );
+            continue;
+        }
+
+        AnswerRequests ( );
+    }
+}
+
+bool Explorer::JumpPlanner::GatherRequests ( )
+{
+    mBatchSlots.clear ( );
+    mBatchRequests.clear ( );
+    mBatchQueries.clear ( );
+
+    for ( size_t slotIndex = 0; slotIndex < mSlots.size ( ); slotIndex++ )
+    {
+        PlanSlot& slot = *mSlots[slotIndex];
+
+        // only as many as can be answered, a full decision queue just waits for the audio thread to catch up
+        size_t space = slot.decisions.Capacity ( ) - slot.decisions.Size ( );
+
+        Request request;
+        while ( space > 0 && slot.requests.Pop ( request ) )
+        {
+            PointPicker::JumpQuery query;
+            query.currentPoint = request.point;
+            query.maxAllowedDistanceSpaceX1000 = request.rules.maxDistanceSpaceX1000;
+            query.maxAllowedTargets = request.rules.maxTargets;
+            query.sameFileAllowed = request.rules.sameFileAllowed;
+            query.minTimeDiffSameFile = request.rules.minTimeDiffSameFile;
+            query.remainingSamplesRequired = request.rules.remainingSamplesRequired;
+
+            mBatchSlots.push_back ( slotIndex );
+            mBatchRequests.push_back ( request );
+            mBatchQueries.push_back ( query );
+            space--;
+        }
+    }
+
+    return !mBatchRequests.empty ( );
+}
+
+void Explorer::JumpPlanner::AnswerRequests ( )
+{
+    size_t count = mBatchRequests.size ( );
+
+    mPointPicker->FindJumpTargets ( mBatchQueries.data ( ), count, *mRawView->GetAudioData ( ), mRawView->GetHopSize ( ), mRawView->GetAudioCache ( ),
+                                    mSearchScratch, mBatchTargets.data ( ), mBatchFound.get ( ) );
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+        Decision decision;
+        decision.generation = mBatchRequests[i].generation;
+        decision.point = mBatchRequests[i].point;
+        decision.found = mBatchFound[i];
+        decision.target = mBatchTargets[i];
+
+        mSlots[mBatchSlots[i]]->decisions.Push ( decision ); // room was checked when gathering, only this thread pushes
+    }
+}
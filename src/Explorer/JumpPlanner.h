@@ -0,0 +1,120 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Explorer/PointPicker.h"
+#include "Explorer/RawView.h"
+#include "Utilities/Data.h"
+#include "Utilities/SPSCQueue.h"
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+namespace Acorex {
+namespace Explorer {
+
+// chooses jump targets ahead of playback, so the audio thread never searches the corpus
+// every playhead owns a slot, the audio thread asks for the targets at upcoming trigger points and a planner thread answers through the slot's queues
+// decisions are keyed by the point they were planned for, so one that no longer matches where the playhead is simply goes unused
+class JumpPlanner {
+public:
+    // the jump settings at the time of asking, so a plan follows the settings the audio thread had
+    struct Rules {
+        int maxDistanceSpaceX1000 = 0;
+        int maxTargets = 1;
+        bool sameFileAllowed = true;
+        int minTimeDiffSameFile = 0;
+        int remainingSamplesRequired = 0;
+    };
+
+    enum class DecisionResult { TARGET, NO_TARGET, NOT_READY };
+
+    JumpPlanner ( );
+    ~JumpPlanner ( ) { Stop ( ); }
+
+    // audio stream must not be running, without a planner thread nothing is answered until PlanNow is called
+    void Initialise ( const std::shared_ptr<PointPicker>& pointPicker, const std::shared_ptr<RawView>& rawView, size_t maxPlayheads, bool plannerThread = true );
+    void Stop ( );
+
+    // answers everything that can be answered, on the calling thread, only without a planner thread and only between audio buffers
+    // offline rendering plans this way, so every jump is decided the same way however fast the buffers go by
+    void PlanNow ( );
+
+    bool IsRunning ( ) const { return bRunning; }
+
+    // audio thread only -------------------------
+
+    int AcquireSlot ( ); // returns -1 if no slot is free
+    void ReleaseSlot ( int slot );
+
+    bool Plan ( int slot, size_t fileIndex, size_t timePointIndex, const Rules& rules ); // returns false if the slot's queue is full
+    void Reset ( int slot ); // everything asked for so far is no longer wanted
+
+    // TARGET only if a target planned for exactly this point is ready, NOT_READY if the planner hasn't answered for it (or skipped past it)
+    // decisions for points already passed are discarded
+    DecisionResult TakeDecision ( int slot, size_t fileIndex, size_t timePointIndex, Utilities::PointFT& target );
+
+private:
+    struct Request {
+        uint32_t generation = 0;
+        Utilities::PointFT point;
+        Rules rules;
+    };
+
+    struct Decision {
+        uint32_t generation = 0;
+        Utilities::PointFT point;
+        bool found = false;
+        Utilities::PointFT target;
+    };
+
+    struct PlanSlot {
+        Utilities::SPSCQueue<Request> requests; // audio thread to planner thread
+        Utilities::SPSCQueue<Decision> decisions; // planner thread to audio thread
+
+        // audio thread only
+        uint32_t generation = 0;
+        bool inUse = false;
+    };
+
+    void PlannerThreadLoop ( );
+    bool GatherRequests ( ); // takes what every slot has room to answer, returns false if there was nothing
+    void AnswerRequests ( );
+
+    std::vector<std::unique_ptr<PlanSlot>> mSlots;
+    std::vector<int> mFreeSlots;
+
+    // planner thread only, everything gathered in one pass is searched together
+    std::vector<size_t> mBatchSlots;
+    std::vector<Request> mBatchRequests;
+    std::vector<PointPicker::JumpQuery> mBatchQueries;
+    std::vector<Utilities::PointFT> mBatchTargets;
+    std::unique_ptr<bool[]> mBatchFound; // sized for the largest possible batch in Initialise
+    Utilities::HNSWIndex::Scratch mSearchScratch; // this planner's own, so an offline planner never searches with the live one's state
+
+    std::shared_ptr<PointPicker> mPointPicker;
+    std::shared_ptr<RawView> mRawView;
+
+    std::thread mPlannerThread;
+    std::atomic<bool> bRunning;
+};
+
+} // namespace Explorer
+} // namespace Acorex
@@ -23,6 +23,8 @@ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 #include <ofGraphics.h>
 #include <of3dUtils.h>
 #include <ofEvents.h>
+#include <ofSystemUtils.h>
+#include <ofFileUtils.h>
 #include <random>
 
 #define TEMPORARY_ACOREX_VISUAL_TRAIL_FADE_UPDATE_INTERVAL 4
@@ -39,7 +41,9 @@ Explorer::LiveView::LiveView ( )
     deltaTime ( 0.1f ), lastUpdateTime ( 0 ),
     mDisabledAxis ( Utilities::Axis::NONE ), xLabel ( "X" ), yLabel ( "Y" ), zLabel ( "Z" ), colorDimension ( -1 ),
     mCamPivot ( ofPoint ( 0, 0, 0 ) ),
-    mLastMouseX ( 0 ), mLastMouseY ( 0 )
+    mLastMouseX ( 0 ), mLastMouseY ( 0 ),
+    bLassoActive ( false ),
+    bOfflineRendering ( false )
 {
     mPointPicker = std::make_shared<Explorer::PointPicker> ( );
     mAudioPlayback.SetPointPicker ( mPointPicker );
@@ -61,6 +65,7 @@ void Explorer::LiveView::Initialise ( )
     mDimensionBounds.CalculateBounds ( *mRawView->GetDataset ( ) );
 
     mAudioPlayback.SetDimensionBounds ( mDimensionBounds.GetBoundsData ( ) );
+    mAudioPlayback.InitialiseStorage ( );
     
     mPointPicker->Initialise ( *mRawView->GetDataset ( ), mDimensionBounds );
 
@@ -71,6 +76,8 @@ void Explorer::LiveView::Clear ( )
 {
     RemoveListeners ( );
 
+    StopOfflineRender ( );
+
     mAudioPlayback.ClearAndKillAudio ( );
 
     mPointPicker->Clear ( );
@@ -81,6 +88,12 @@ void Explorer::LiveView::Clear ( )
 
     mPlayheads.clear ( );
 
+    bLassoActive = false;
+    mLasso.clear ( );
+    mSelection.Resize ( 0 );
+    mSelectedPoints.clear ( );
+    mSelectionMesh.clear ( );
+
     bDraw = false;
     b3D = true;
     bColorFullSpectrum = false;
@@ -102,6 +115,7 @@ bool Explorer::LiveView::StartAudio ( std::pair<ofSoundDevice, int> audioSetting
 void Explorer::LiveView::Exit ( )
 {
     RemoveListeners ( );
+    StopOfflineRender ( );
     mPointPicker->Exit ( );
 }
 
@@ -180,17 +194,21 @@ void Explorer::LiveView::Update ( )
         }
     }
 
+    mPointPicker->FindNearestToMouse ( );
+
     UpdatePlayheads ( );
 }
 
 void Explorer::LiveView::UpdatePlayheads ( )
 {
-    std::vector<Utilities::VisualPlayhead> playheadUpdates = mAudioPlayback.GetPlayheadInfo ( );
+    const AudioPlayback::PlayheadStates& playheadUpdates = mAudioPlayback.GetPlayheadStates ( );
+    const Utilities::PlayheadState* updatesBegin = playheadUpdates.playheads;
+    const Utilities::PlayheadState* updatesEnd = playheadUpdates.playheads + playheadUpdates.count;
 
     // remove playheads that aren't in the update list
     for ( int i = 0; i < mPlayheads.size ( ); i++ )
     {
-        if ( std::find_if ( playheadUpdates.begin ( ), playheadUpdates.end ( ), [this, i]( Utilities::VisualPlayhead& playhead ) { return playhead.playheadID == mPlayheads[i].playheadID; } ) == playheadUpdates.end ( ) )
+        if ( std::find_if ( updatesBegin, updatesEnd, [this, i]( const Utilities::PlayheadState& playhead ) { return playhead.playheadID == mPlayheads[i].playheadID; } ) == updatesEnd )
         {
             ofLogVerbose ( "LiveView" ) << "Playhead " << mPlayheads[i].playheadID << " deleted";
 
@@ -212,36 +230,26 @@ void Explorer::LiveView::UpdatePlayheads ( )
     }
 
     // go through playheadUpdates and update the respective playheads or add new ones if the ID isn't found
-    for ( int i = 0; i < playheadUpdates.size ( ); i++ )
+    for ( size_t i = 0; i < playheadUpdates.count; i++ )
     {
-        auto it = std::find_if ( mPlayheads.begin ( ), mPlayheads.end ( ), [this, i, &playheadUpdates] ( Utilities::VisualPlayhead& playhead ) { return playhead.playheadID == playheadUpdates[i].playheadID; } );
+        const Utilities::PlayheadState& update = playheadUpdates.playheads[i];
+        auto it = std::find_if ( mPlayheads.begin ( ), mPlayheads.end ( ), [&update] ( Utilities::VisualPlayhead& playhead ) { return playhead.playheadID == update.playheadID; } );
         if ( it != mPlayheads.end ( ) )
         {
-            ofColor color = it->color;
-            ofRectangle panelRect = it->panelRect;
-            ofRectangle playheadColorRect = it->playheadColorRect;
-            ofRectangle killButtonRect = it->killButtonRect;
-            bool highlight = it->highlight;
-
-            *it = playheadUpdates[i];
-
-            it->color = color;
-            it->panelRect = panelRect;
-            it->playheadColorRect = playheadColorRect;
-            it->killButtonRect = killButtonRect;
-            it->highlight = highlight;
+            it->fileIndex = update.fileIndex;
+            it->sampleIndex = update.sampleIndex;
         }
         else
         {
-            ofLogVerbose ( "LiveView" ) << "Playhead " << playheadUpdates[i].playheadID << " added";
+            ofLogVerbose ( "LiveView" ) << "Playhead " << update.playheadID << " added";
 
-            mPlayheads.push_back ( playheadUpdates[i] );
+            mPlayheads.push_back ( Utilities::VisualPlayhead ( update.playheadID, update.fileIndex, update.sampleIndex ) );
             std::random_device rd;
             std::mt19937 gen ( rd ( ) );
             std::uniform_int_distribution<> dis ( 0, 255 );
             ofColor randomPlayheadColor = ofColor::fromHsb ( dis ( gen ), 255, 255 );
 
-            mPlayheadTrails.push_back ( Utilities::VisualPlayheadTrail ( playheadUpdates[i].playheadID, randomPlayheadColor, TEMPORARY_ACOREX_VISUAL_TRAIL_MAX_LENGTH, TEMPORARY_ACOREX_VISUAL_TRAIL_FADE_UPDATE_INTERVAL ) );
+            mPlayheadTrails.push_back ( Utilities::VisualPlayheadTrail ( update.playheadID, randomPlayheadColor, TEMPORARY_ACOREX_VISUAL_TRAIL_MAX_LENGTH, TEMPORARY_ACOREX_VISUAL_TRAIL_FADE_UPDATE_INTERVAL ) );
 
             mPlayheads.back ( ).color = randomPlayheadColor;
             mPlayheads.back ( ).ResizeBox ( mPlayheads.size ( ) - 1, mLayout->getTopBarHeight ( ), ofGetHeight ( ), ofGetWidth ( ) );
@@ -280,11 +288,6 @@ void Explorer::LiveView::UpdatePlayheads ( )
     }
 }
 
-void Explorer::LiveView::SlowUpdate ( )
-{
-    mPointPicker->FindNearestToMouse ( );
-}
-
 void Explorer::LiveView::Draw ( )
 {
     if ( !bDraw ) { return; }
@@ -339,6 +342,12 @@ void Explorer::LiveView::Draw ( )
             ofDisableDepthTest ( );
         }
 
+        if ( !mSelectedPoints.empty ( ) )
+        {
+            ofSetColor ( 255, 255, 255 );
+            mSelectionMesh.draw ( );
+        }
+
         for ( auto& trail : mPlayheadTrails )
         {
             trail.Draw ( );
@@ -417,6 +426,18 @@ void Explorer::LiveView::Draw ( )
     ofDisableAlphaBlending ( );
     ofDisableDepthTest ( );
 
+    // Draw Lasso -------------------------------
+    if ( bLassoActive )
+    {
+        ofSetColor ( 255, 255, 255 );
+        for ( size_t i = 1; i < mLasso.size ( ); i++ ) { ofDrawLine ( mLasso[i - 1].x, mLasso[i - 1].y, mLasso[i].x, mLasso[i].y ); }
+    }
+
+    if ( !mSelectedPoints.empty ( ) )
+    {
+        ofDrawBitmapStringHighlight ( "Selected: " + std::to_string ( mSelectedPoints.size ( ) ) + " points", ofGetWidth ( ) - 200, ofGetHeight ( ) - 100 );
+    }
+
     // Draw Nearest Point -----------------------
     mPointPicker->Draw ( );
     if ( mPointPicker->GetNearestMousePointFile ( ) != -1 )
@@ -428,6 +449,53 @@ void Explorer::LiveView::Draw ( )
         //ofDrawBitmapStringHighlight ( "Nearest Timepoint: " + hopInfoSamps + " samples, " + hopInfoSecs + "s", 20, ofGetHeight ( ) - 40 );
     }
 
+    // Debug overlay ----------------------------
+    if ( bDebug )
+    {
+        AudioPlayback::Telemetry telemetry = mAudioPlayback.GetTelemetry ( );
+
+        std::string loadHistogram;
+        for ( int i = 0; i < AudioPlayback::kLoadHistogramBuckets; i++ )
+        {
+            std::string range = i == 0 ? "<" + std::to_string ( AudioPlayback::kLoadHistogramEdgesPercent[0] )
+                                : i == AudioPlayback::kLoadHistogramBuckets - 1 ? ">" + std::to_string ( AudioPlayback::kLoadHistogramEdgesPercent[i - 1] )
+                                : std::to_string ( AudioPlayback::kLoadHistogramEdgesPercent[i - 1] ) + "-" + std::to_string ( AudioPlayback::kLoadHistogramEdgesPercent[i] );
+            loadHistogram += ( i > 0 ? ", " : "" ) + range + "%: " + std::to_string ( telemetry.loadHistogram[i] );
+        }
+
+        std::string jumpsSkipped;
+        for ( int i = 0; i < AudioPlayback::JUMP_SKIP_CAUSES; i++ )
+        {
+            jumpsSkipped += ", " + std::to_string ( telemetry.jumpsSkipped[i] ) + " " + AudioPlayback::GetJumpSkipCauseName ( i );
+        }
+
+        ofDrawBitmapStringHighlight ( "Audio load: " + std::to_string ( (int)telemetry.loadPercent ) + "% (" + std::to_string ( (int)telemetry.peakLoadPercent ) + "% peak), "
+                                        + std::to_string ( telemetry.overruns ) + " overruns, " + std::to_string ( telemetry.lateCallbacks ) + " late, "
+                                        + std::to_string ( telemetry.callbacks ) + " callbacks, " + QualityGovernor::GetLevelName ( telemetry.qualityLevel ), 20, ofGetHeight ( ) - 140 );
+        ofDrawBitmapStringHighlight ( "Callback load: " + loadHistogram, 20, ofGetHeight ( ) - 120 );
+        ofDrawBitmapStringHighlight ( "Jumps: " + std::to_string ( telemetry.jumpsTaken ) + " taken" + jumpsSkipped, 20, ofGetHeight ( ) - 100 );
+        ofDrawBitmapStringHighlight ( "Voices: " + std::to_string ( telemetry.voicesEnded ) + " ended, " + std::to_string ( telemetry.voicesKilled ) + " killed, " + std::to_string ( telemetry.voicesShed ) + " shed, "
+                                        + std::to_string ( telemetry.createsRefused ) + " creates refused, " + std::to_string ( telemetry.commandsDropped ) + " commands dropped", 20, ofGetHeight ( ) - 80 );
+    }
+
+    if ( bDebug && mRawView->GetAudioCache ( ) != nullptr )
+    {
+        AudioCache::Stats cacheStats = mRawView->GetAudioCache ( )->GetStats ( );
+        uint64_t accesses = cacheStats.hits + cacheStats.misses;
+        int hitRatePercent = accesses > 0 ? (int)(cacheStats.hits * 100 / accesses) : 0;
+
+        ofDrawBitmapStringHighlight ( "Audio cache: " + std::to_string ( cacheStats.residentFiles ) + " files, "
+                                        + std::to_string ( cacheStats.residentBytes / (1024 * 1024) ) + "/" + std::to_string ( cacheStats.budgetBytes / (1024 * 1024) ) + " MB, "
+                                        + std::to_string ( hitRatePercent ) + "% hits, " + std::to_string ( cacheStats.loads ) + " loads, "
+                                        + std::to_string ( cacheStats.evictions ) + " evictions", 20, ofGetHeight ( ) - 60 );
+    }
+
+    if ( bOfflineRendering )
+    {
+        int percent = (int)( mOfflineRenderer->GetProgress ( ) * 100.0f );
+        ofDrawBitmapStringHighlight ( "Rendering offline: " + std::to_string ( percent ) + "%", ofGetWidth ( ) - 200, ofGetHeight ( ) - 60 );
+    }
+
     // Paused overlay ---------------------------
     if ( bUserPaused )
     {
@@ -463,6 +531,14 @@ void Explorer::LiveView::CreatePlayhead ( size_t fileIndex, size_t timePointInde
 
 void Explorer::LiveView::CreatePlayheadRandom ( )
 {
+    if ( !mSelectedPoints.empty ( ) )
+    {
+        std::uniform_int_distribution<size_t> disPoint ( 0, mSelectedPoints.size ( ) - 1 );
+        Utilities::PointFT randomPoint = mSelectedPoints[disPoint ( mRandomGen )];
+        CreatePlayhead ( randomPoint.file, randomPoint.time );
+        return;
+    }
+
     std::uniform_int_distribution<> disFile ( 0, mRawView->GetDataset ( )->fileList.size ( ) - 1 );
     size_t randomFile = disFile ( mRandomGen );
     std::uniform_int_distribution<> disTime ( 0, mRawView->GetTrailData ( )->raw[randomFile].size ( ) - 1 );
@@ -480,6 +556,88 @@ void Explorer::LiveView::KillPlayhead ( size_t playheadID )
     mAudioPlayback.KillPlayhead ( playheadID );
 }
 
+void Explorer::LiveView::RenderOffline ( )
+{
+    if ( bOfflineRendering )
+    {
+        ofLogWarning ( "LiveView" ) << "An offline render is already running";
+        return;
+    }
+
+    ofFileDialogResult scriptFile = ofSystemLoadDialog ( "Select a render script...", false, ofFilePath::getCurrentWorkingDirectory ( ) );
+    if ( !scriptFile.bSuccess )
+    {
+        ofLogWarning ( "LiveView" ) << "No render script selected";
+        return;
+    }
+
+    ofFileDialogResult outputFile = ofSystemSaveDialog ( "acorex_render.wav", "Save render as..." );
+    if ( !outputFile.bSuccess )
+    {
+        ofLogError ( "LiveView" ) << "Invalid save query";
+        return;
+    }
+
+    std::string outputPath = outputFile.getPath ( );
+    if ( outputFile.getName ( ).find ( ".wav" ) == std::string::npos ) { outputPath += ".wav"; }
+
+    StopOfflineRender ( ); // the last render has finished, its thread just needs joining
+
+    mOfflineRenderer = std::make_unique<OfflineRenderer> ( );
+    mOfflineRenderer->Initialise ( mRawView, mPointPicker, mDimensionBounds.GetBoundsData ( ) );
+
+    OfflineRenderer::Script script;
+    if ( !mOfflineRenderer->LoadScript ( scriptFile.getPath ( ), script ) ) { mOfflineRenderer.reset ( ); return; }
+
+    // the live view keeps drawing and playing meanwhile, Draw shows how far along it is
+    bOfflineRendering = true;
+    mOfflineRenderThread = std::thread ( [this, script, outputPath] ( )
+    {
+        OfflineRenderer::Report report;
+        mOfflineRenderer->Render ( script, outputPath, report );
+        bOfflineRendering = false;
+    } );
+}
+
+void Explorer::LiveView::SelectLasso ( )
+{
+    bLassoActive = false;
+
+    if ( mLasso.size ( ) >= 3 ) { mPointPicker->SelectInLasso ( mLasso, mSelection ); }
+    else if ( mPointPicker->GetNearestMousePointFile ( ) != -1 )
+    {
+        Utilities::PointFT picked;
+        picked.file = mPointPicker->GetNearestMousePointFile ( );
+        picked.time = mPointPicker->GetNearestMousePointTime ( );
+        mPointPicker->SelectNearPoint ( picked, (float)DEFAULT_SELECTION_CLICK_RADIUS_X1000 / 1000.0f, DEFAULT_SELECTION_CLICK_MAX_POINTS, mSelection );
+    }
+    else { mSelection.Resize ( 0 ); }
+
+    mPointPicker->GetSelectedPoints ( mSelection, mSelectedPoints );
+    RebuildSelectionMesh ( );
+
+    mLasso.clear ( );
+}
+
+void Explorer::LiveView::RebuildSelectionMesh ( )
+{
+    mSelectionMesh.clear ( );
+    mSelectionMesh.setMode ( OF_PRIMITIVE_POINTS );
+    for ( const Utilities::PointFT& point : mSelectedPoints ) { mSelectionMesh.addVertex ( mCorpusMesh[point.file].getVertex ( point.time ) ); }
+}
+
+void Explorer::LiveView::StopOfflineRender ( )
+{
+    if ( mOfflineRenderThread.joinable ( ) )
+    {
+        mOfflineRenderer->Cancel ( );
+        mOfflineRenderThread.join ( );
+    }
+
+    mOfflineRenderer.reset ( );
+    bOfflineRendering = false;
+}
+
 // Filler Functions ----------------------------
 
 void Explorer::LiveView::CreatePoints ( )
@@ -498,8 +656,6 @@ void Explorer::LiveView::CreatePoints ( )
         mCorpusMesh.push_back ( mesh );
     }
 
-    mAudioPlayback.SetCorpusMesh ( mCorpusMesh );
-
     bDraw = true;
 }
 
@@ -543,7 +699,7 @@ void Explorer::LiveView::FillDimension ( int dimensionIndex, Utilities::Axis axi
         }
     }
 
-    mAudioPlayback.SetCorpusMesh ( mCorpusMesh );
+    if ( axis != Utilities::Axis::COLOR ) { RebuildSelectionMesh ( ); }
 
     mPointPicker->Train ( dimensionIndex, axis, false );
 }
@@ -575,7 +731,7 @@ void Explorer::LiveView::ClearDimension ( Utilities::Axis axis )
         }
     }
 
-    mAudioPlayback.SetCorpusMesh ( mCorpusMesh );
+    if ( axis != Utilities::Axis::COLOR ) { RebuildSelectionMesh ( ); }
 
     mPointPicker->Train ( -1, axis, true );
 }
@@ -736,7 +892,15 @@ void Explorer::LiveView::MouseEvent ( ofMouseEventArgs& args )
     //position: x, y
     //scroll direction: x, y
 
-    if ( bMouseCameraControl && b3D )
+    // shift + left drag draws a lasso, the points inside it are selected when the button is let go, a shift click on its own selects around the picked point, or clears the selection off the points
+    bool lassoEvent = args.type == 0 || args.type == 2 || args.type == 3;
+    if ( lassoEvent && args.button == OF_MOUSE_BUTTON_LEFT && ( bLassoActive || args.hasModifier ( OF_KEY_SHIFT ) ) )
+    {
+        if ( args.type == 0 ) { bLassoActive = true; mLasso.clear ( ); }
+        if ( bLassoActive ) { mLasso.push_back ( { args.x, args.y } ); }
+        if ( args.type == 2 && bLassoActive ) { SelectLasso ( ); }
+    }
+    else if ( bMouseCameraControl && b3D )
     {
         if ( args.type == 4 ) // scroll - zoom
         {
@@ -808,6 +972,7 @@ void Explorer::LiveView::KeyEvent ( ofKeyEventArgs& args )
         else if ( args.key == ACOREX_KEYBIND_CREATE_PLAYHEAD_RANDOM_POINT ) { CreatePlayheadRandom ( ); }
         else if ( args.key == ACOREX_KEYBIND_CREATE_PLAYHEAD_PICKER_POINT ) { CreatePlayhead ( ); }
         else if ( args.key == ACOREX_KEYBIND_AUDIO_PAUSE ) { bUserPaused = !bUserPaused; mAudioPlayback.UserInvokedPause ( bUserPaused ); }
+        else if ( args.key == ACOREX_KEYBIND_RENDER_OFFLINE ) { RenderOffline ( ); }
         else if ( args.key == ACOREX_KEYBIND_TOGGLE_DEBUG_VIEW ) { bDebug = !bDebug; }
         else if ( args.key == ACOREX_KEYBIND_TOGGLE_MOUSE_CAMERA_CONTROL ) { bMouseCameraControl = !bMouseCameraControl; }
         else if ( args.key == ACOREX_KEYBIND_TOGGLE_DRAWING_AXES ) { bDrawAxes = !bDrawAxes; }
@@ -20,13 +20,17 @@ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 #include "Explorer/PointPicker.h"
 #include "Explorer/RawView.h"
 #include "Explorer/AudioPlayback.h"
+#include "Explorer/OfflineRenderer.h"
 #include "Utilities/Data.h"
 #include "Utilities/DimensionBounds.h"
+#include "Utilities/PointSelection.h"
 #include "Utilities/InterfaceDefs.h"
 
 #include <ofMesh.h>
 #include <ofEasyCam.h>
 #include <random>
+#include <thread>
+#include <atomic>
 
 namespace Acorex {
 namespace Explorer {
@@ -35,7 +39,7 @@ class LiveView {
 public:
 
     LiveView ( );
-    ~LiveView ( ) { }
+    ~LiveView ( ) { StopOfflineRender ( ); }
 
     void Initialise ( );
     void Clear ( );
@@ -50,16 +54,24 @@ public:
 
     void Update ( );
     void UpdatePlayheads ( );
-    void SlowUpdate ( );
     void Draw ( );
 
     // Sound Functions ------------------------------
 
     void CreatePlayhead ( );
     void CreatePlayhead ( size_t fileIndex, size_t timePointIndex );
-    void CreatePlayheadRandom ( );
+    void CreatePlayheadRandom ( ); // inside the selection, if there is one
     void PickRandomPoint ( );
     void KillPlayhead ( size_t playheadID );
+    void RenderOffline ( ); // asks for a render script and where to write the result, then renders it in the background without the audio device
+    void StopOfflineRender ( ); // cancels a render still running and waits for it
+
+    // Selection Functions -------------------------
+
+    // selects the points inside the lasso drawn so far, a lasso too small to enclose anything is a click,
+    // which selects the points around the picked point, or clears the selection if nothing is picked
+    void SelectLasso ( );
+    void RebuildSelectionMesh ( ); // after the selection or the axes change
 
     // Filler Functions ----------------------------
 
@@ -91,6 +103,7 @@ public:
     std::vector<Utilities::VisualPlayhead>& GetPlayheads ( ) { return mPlayheads; }
 
     AudioPlayback* GetAudioPlayback ( ) { return &mAudioPlayback; }
+    PointPicker* GetPointPicker ( ) { return mPointPicker.get ( ); }
 
     // Listener Functions --------------------------
 
@@ -145,6 +158,20 @@ private:
     // Randomness ----------------------------------
 
     std::mt19937 mRandomGen;
+
+    // Selection -----------------------------------
+
+    bool bLassoActive;
+    std::vector<glm::vec2> mLasso; // pixels, as the mouse reported them
+    Utilities::PointSelection mSelection;
+    std::vector<Utilities::PointFT> mSelectedPoints;
+    ofMesh mSelectionMesh; // copies of the selected points' corpus mesh vertices
+
+    // Offline Rendering ---------------------------
+
+    std::unique_ptr<OfflineRenderer> mOfflineRenderer;
+    std::thread mOfflineRenderThread;
+    std::atomic<bool> bOfflineRendering;
 };
 
 } // namespace Explorer
@@ -0,0 +1,241 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Explorer/OfflineRenderer.h"
+
+#include <dr_wav.h>
+#include <nlohmann/json.hpp>
+#include <ofLog.h>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+
+using namespace Acorex;
+
+void Explorer::OfflineRenderer::Initialise ( const std::shared_ptr<RawView>& rawView, const std::shared_ptr<PointPicker>& pointPicker, const Utilities::DimensionBoundsData& dimensionBounds )
+{
+    mRawView = rawView;
+    mPointPicker = pointPicker;
+    mDimensionBounds = dimensionBounds;
+}
+
+bool Explorer::OfflineRenderer::LoadScript ( const std::string& inputFile, Script& script ) const
+{
+    static const std::map<std::string, Event::Type> eventTypes = {
+        { "createPlayhead", Event::Type::CreatePlayhead },
+        { "killPlayhead", Event::Type::KillPlayhead },
+        { "setVolume", Event::Type::SetVolume },
+        { "setLoopPlayheads", Event::Type::SetLoopPlayheads },
+        { "setJumpSameFileAllowed", Event::Type::SetJumpSameFileAllowed },
+        { "setJumpSameFileMinTimeDiff", Event::Type::SetJumpSameFileMinTimeDiff },
+        { "setCrossoverJumpChance", Event::Type::SetCrossoverJumpChance },
+        { "setCrossfadeSampleLength", Event::Type::SetCrossfadeSampleLength },
+        { "setMaxJumpDistanceSpace", Event::Type::SetMaxJumpDistanceSpace },
+        { "setMaxJumpTargets", Event::Type::SetMaxJumpTargets },
+        { "setDynamicPan", Event::Type::SetDynamicPan },
+        { "setPanningStrength", Event::Type::SetPanningStrength } };
+
+    if ( !mRawView )
+    {
+        ofLogError ( "OfflineRenderer" ) << "No corpus loaded, failed to read render script " << inputFile;
+        return false;
+    }
+
+    double sampleRate = mRawView->GetDataset ( )->analysisSettings.sampleRate;
+
+    try
+    {
+        std::ifstream file ( inputFile );
+        nlohmann::json j;
+
+        file >> j;
+        file.close ( );
+
+        script = Script ( );
+        script.seed = j.at ( "seed" ).get<uint32_t> ( );
+        script.lengthSamples = (uint64_t)std::llround ( j.at ( "length" ).get<double> ( ) * sampleRate );
+        if ( j.contains ( "bufferSize" ) ) { script.bufferSize = j.at ( "bufferSize" ).get<size_t> ( ); }
+
+        for ( const auto& jEvent : j.at ( "events" ) )
+        {
+            std::string typeName = jEvent.at ( "type" ).get<std::string> ( );
+            auto type = eventTypes.find ( typeName );
+            if ( type == eventTypes.end ( ) )
+            {
+                ofLogError ( "OfflineRenderer" ) << "Unknown event type \"" << typeName << "\" in render script " << inputFile;
+                return false;
+            }
+
+            Event event;
+            event.type = type->second;
+            event.atSample = (uint64_t)std::llround ( std::max ( jEvent.at ( "time" ).get<double> ( ), 0.0 ) * sampleRate );
+
+            if ( event.type == Event::Type::CreatePlayhead )
+            {
+                event.fileIndex = jEvent.at ( "file" ).get<size_t> ( );
+                event.timePointIndex = jEvent.at ( "timePoint" ).get<size_t> ( );
+            }
+            else if ( event.type == Event::Type::KillPlayhead )
+            {
+                event.playheadID = jEvent.at ( "playhead" ).get<size_t> ( );
+            }
+            else
+            {
+                event.value = jEvent.at ( "value" ).get<int> ( );
+                if ( event.type == Event::Type::SetDynamicPan ) { event.dimensionIndex = jEvent.at ( "dimension" ).get<int> ( ); }
+            }
+
+            script.events.push_back ( event );
+        }
+    }
+    catch ( std::exception& e )
+    {
+        ofLogError ( "OfflineRenderer" ) << "failed to read render script " << inputFile << " : " << e.what ( );
+        return false;
+    }
+
+    return true;
+}
+
+bool Explorer::OfflineRenderer::Render ( const Script& script, const std::string& outputFile, Report& report )
+{
+    report = Report ( );
+    mProgress = 0.0f;
+
+    if ( !mRawView || !mPointPicker || mRawView->GetDataset ( )->fileList.empty ( ) )
+    {
+        ofLogError ( "OfflineRenderer" ) << "No corpus loaded, nothing to render";
+        return false;
+    }
+
+    size_t sampleRate = (size_t)mRawView->GetDataset ( )->analysisSettings.sampleRate;
+
+    // one trigger point at most per playhead per buffer, so every jump target is planned before the buffer that takes it
+    size_t bufferSize = std::max ( std::min ( script.bufferSize, mRawView->GetHopSize ( ) ), (size_t)1 );
+
+    drwav_data_format format;
+    format.container = drwav_container_riff;
+    format.format = DR_WAVE_FORMAT_IEEE_FLOAT;
+    format.channels = 2;
+    format.sampleRate = (uint32_t)sampleRate;
+    format.bitsPerSample = 32;
+
+    drwav wav;
+    if ( !drwav_init_file_write ( &wav, outputFile.c_str ( ), &format, NULL ) )
+    {
+        ofLogError ( "OfflineRenderer" ) << "Failed to open " << outputFile << " for writing";
+        return false;
+    }
+
+    // a playback of its own, so a live stream can keep running alongside
+    std::unique_ptr<AudioPlayback> playback = std::make_unique<AudioPlayback> ( );
+    playback->SetRawView ( mRawView );
+    playback->SetPointPicker ( mPointPicker );
+    playback->SetDimensionBounds ( mDimensionBounds );
+    playback->SetRandomSeed ( script.seed );
+    playback->InitialiseStorage ( true );
+    playback->StartOffline ( sampleRate, bufferSize );
+
+    std::vector<Event> events = script.events;
+    std::stable_sort ( events.begin ( ), events.end ( ), [] ( const Event& a, const Event& b ) { return a.atSample < b.atSample; } );
+    size_t nextEvent = 0;
+
+    ofSoundBuffer buffer;
+    buffer.setSampleRate ( sampleRate );
+    buffer.allocate ( bufferSize, 2 );
+
+    bool success = true;
+    auto start = std::chrono::steady_clock::now ( );
+
+    while ( report.samplesRendered < script.lengthSamples )
+    {
+        if ( bCancelled )
+        {
+            ofLogWarning ( "OfflineRenderer" ) << "Render to " << outputFile << " cancelled after " << report.samplesRendered << " samples";
+            success = false;
+            break;
+        }
+
+        size_t frames = (size_t)std::min ( (uint64_t)bufferSize, script.lengthSamples - report.samplesRendered );
+        if ( frames != buffer.getNumFrames ( ) ) { buffer.allocate ( frames, 2 ); }
+
+        // playhead commands land on their sample, setting changes on the start of the buffer they fall in, as they would live
+        while ( nextEvent < events.size ( ) && events[nextEvent].atSample < report.samplesRendered + frames )
+        {
+            ApplyEvent ( *playback, events[nextEvent] );
+            nextEvent++;
+        }
+
+        playback->RenderOffline ( buffer );
+
+        for ( float sample : buffer.getBuffer ( ) ) { report.peak = std::max ( report.peak, std::abs ( sample ) ); }
+
+        if ( drwav_write_pcm_frames ( &wav, frames, buffer.getBuffer ( ).data ( ) ) != frames )
+        {
+            ofLogError ( "OfflineRenderer" ) << "Failed writing to " << outputFile << ", render stopped after " << report.samplesRendered << " samples";
+            success = false;
+            break;
+        }
+
+        report.samplesRendered += frames;
+        mProgress = (float)( (double)report.samplesRendered / (double)script.lengthSamples );
+    }
+
+    report.renderSeconds = std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - start ).count ( );
+    report.audioSeconds = (double)report.samplesRendered / (double)sampleRate;
+    report.realtimeMultiple = report.audioSeconds / std::max ( report.renderSeconds, 1e-9 );
+
+    playback->ClearAndKillAudio ( );
+    drwav_uninit ( &wav );
+
+    if ( success )
+    {
+        ofLogNotice ( "OfflineRenderer" ) << "Rendered " << report.audioSeconds << "s to " << outputFile << " in " << report.renderSeconds << "s, "
+            << report.realtimeMultiple << "x realtime, peak " << report.peak;
+    }
+
+    return success;
+}
+
+bool Explorer::OfflineRenderer::ApplyEvent ( AudioPlayback& playback, const Event& event )
+{
+    switch ( event.type )
+    {
+    case Event::Type::CreatePlayhead:
+        if ( event.fileIndex >= mRawView->GetDataset ( )->fileList.size ( ) )
+        {
+            ofLogWarning ( "OfflineRenderer" ) << "Render script creates a playhead in file " << event.fileIndex << ", which is not in the corpus";
+            return false;
+        }
+        return playback.CreatePlayhead ( event.fileIndex, event.timePointIndex, event.atSample );
+    case Event::Type::KillPlayhead:                 return playback.KillPlayhead ( event.playheadID, event.atSample );
+    case Event::Type::SetVolume:                    return playback.SetVolumeX1000 ( event.value, event.atSample );
+    case Event::Type::SetLoopPlayheads:             playback.SetLoopPlayheads ( event.value != 0 ); return true;
+    case Event::Type::SetJumpSameFileAllowed:       playback.SetJumpSameFileAllowed ( event.value != 0 ); return true;
+    case Event::Type::SetJumpSameFileMinTimeDiff:   playback.SetJumpSameFileMinTimeDiff ( event.value ); return true;
+    case Event::Type::SetCrossoverJumpChance:       playback.SetCrossoverJumpChanceX1000 ( event.value ); return true;
+    case Event::Type::SetCrossfadeSampleLength:     playback.SetCrossfadeSampleLength ( event.value ); return true;
+    case Event::Type::SetMaxJumpDistanceSpace:      playback.SetMaxJumpDistanceSpace ( event.value ); return true;
+    case Event::Type::SetMaxJumpTargets:            playback.SetMaxJumpTargets ( event.value ); return true;
+    case Event::Type::SetDynamicPan:                playback.SetDynamicPan ( event.value != 0, event.dimensionIndex ); return true;
+    case Event::Type::SetPanningStrength:           playback.SetPanningStrengthX1000 ( event.value ); return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,109 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Explorer/AudioPlayback.h"
+#include "Explorer/RawView.h"
+#include "Explorer/PointPicker.h"
+#include "Utilities/DimensionBounds.h"
+#include "Utilities/TemporaryDefaults.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+namespace Acorex {
+namespace Explorer {
+
+// renders a scripted session through the same playback path as the live view, with no audio device, as fast as the machine allows
+// a script is a random seed, a length, and timed playhead creations, kills and setting changes, the result is written to a WAV file
+// with the corpus held in memory the same script always renders the same audio, cached or streamed corpora wait on the disk but can
+// still jump differently, as targets are only taken from files that happen to be loaded
+class OfflineRenderer {
+public:
+    struct Event {
+        enum class Type {
+            CreatePlayhead, // fileIndex, timePointIndex
+            KillPlayhead, // playheadID, counting successful creations from 0 in script order
+            SetVolume, // value, out of 1000
+            SetLoopPlayheads, // value, 0 or 1
+            SetJumpSameFileAllowed, // value, 0 or 1
+            SetJumpSameFileMinTimeDiff, // value, in time points
+            SetCrossoverJumpChance, // value, out of 1000
+            SetCrossfadeSampleLength, // value, in samples
+            SetMaxJumpDistanceSpace, // value, x1000
+            SetMaxJumpTargets, // value
+            SetDynamicPan, // value, 0 or 1, dimensionIndex
+            SetPanningStrength // value, out of 1000
+        };
+
+        Type type = Type::CreatePlayhead;
+        uint64_t atSample = 0;
+
+        size_t fileIndex = 0;
+        size_t timePointIndex = 0;
+        size_t playheadID = 0;
+        int value = 0;
+        int dimensionIndex = 0;
+    };
+
+    struct Script {
+        uint32_t seed = 0;
+        uint64_t lengthSamples = 0;
+        size_t bufferSize = DEFAULT_OFFLINE_RENDER_BUFFER_SIZE;
+        std::vector<Event> events; // any order, sorted by time when rendered, events at the same time keep their order
+    };
+
+    struct Report {
+        uint64_t samplesRendered = 0;
+        double audioSeconds = 0.0;
+        double renderSeconds = 0.0;
+        double realtimeMultiple = 0.0; // audio seconds rendered per second taken
+        float peak = 0.0f;
+    };
+
+    OfflineRenderer ( ) : mProgress ( 0.0f ), bCancelled ( false ) { }
+    ~OfflineRenderer ( ) { }
+
+    void Initialise ( const std::shared_ptr<RawView>& rawView, const std::shared_ptr<PointPicker>& pointPicker, const Utilities::DimensionBoundsData& dimensionBounds );
+
+    // json with "seed", "length" in seconds, an optional "bufferSize", and "events", each with a "time" in seconds,
+    // a "type" spelt as in Event::Type but starting lower case - "createPlayhead", "setVolume" - and the fields that type uses
+    bool LoadScript ( const std::string& inputFile, Script& script ) const;
+
+    bool Render ( const Script& script, const std::string& outputFile, Report& report ); // 32 bit float stereo at the corpus sample rate
+
+    // safe to call from another thread while Render runs
+    float GetProgress ( ) const { return mProgress; } // 0 to 1, of the script's length
+    void Cancel ( ) { bCancelled = true; } // Render stops after its current buffer and returns false, leaving what was written so far
+
+private:
+    bool ApplyEvent ( AudioPlayback& playback, const Event& event );
+
+    std::shared_ptr<RawView> mRawView;
+    std::shared_ptr<PointPicker> mPointPicker;
+    Utilities::DimensionBoundsData mDimensionBounds;
+
+    std::atomic<float> mProgress;
+    std::atomic<bool> bCancelled;
+};
+
+} // namespace Explorer
+} // namespace Acorex
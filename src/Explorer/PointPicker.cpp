@@ -21,6 +21,8 @@ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 
 #include <ofGraphics.h>
 #include <of3DGraphics.h>
+#include <algorithm>
+#include <cmath>
 
 using namespace Acorex;
 
@@ -28,11 +30,14 @@ Explorer::PointPicker::PointPicker ( )
     :   bListenersAdded ( false ), bDebug (false ),
         bTrained ( false ), bSkipTraining ( true ),
         b3D ( true ), bPicker ( false ), bClicked ( false ), bNearestMouseCheckNeeded ( false ),
-        bDimensionsFilled { false, false, false }, mDimensionsIndices { -1, -1, -1 },
+        bDimensionsFilled { false, false, false }, mDimensionsIndices { -1, -1, -1 }, bJumpAllDimensions ( false ),
         mNearestPoint ( -1 ), mNearestDistance ( -1 ),
-        maxAllowedDistanceFar ( 0.05 ), maxAllowedDistanceNear ( 0.01 ),
-        mNearestPointFile ( -1 ), mNearestPointTime ( -1 )
+        maxAllowedDistanceFar ( 0.05 ), maxAllowedDistanceNear ( 0.01 ), mDesiredRayLength ( 15000.0 ),
+        mNearestPointFile ( -1 ), mNearestPointTime ( -1 ),
+        mTrainGeneration ( 0 ), bTrainPending ( false ), bTrainThreadExit ( false )
 {
+    mDebugRayStart = glm::vec3 ( 0.0f, 0.0f, 0.0f );
+    mDebugRayEnd = glm::vec3 ( 0.0f, 0.0f, 0.0f );
     mRandomGen = std::mt19937 ( std::random_device ( ) () );
 }
 
@@ -42,25 +47,31 @@ void Explorer::PointPicker::Initialise ( const Utilities::DataSet& dataset, cons
 
     std::lock_guard<std::mutex> lock ( mPointPickerMutex );
 
-    mFullFluidSet = fluid::FluidDataSet<std::string, double, 1> ( dataset.dimensionNames.size ( ) );
-    mLiveFluidSet = fluid::FluidDataSet<std::string, double, 1> ( 3 );
-
     Utilities::DataSet scaledDataset = dataset;
     ScaleDataset ( scaledDataset, dimensionBounds );
 
+    auto corpus = std::make_shared<ScaledCorpus> ( );
+    corpus->columns.resize ( dataset.dimensionNames.size ( ) );
+
     for ( int file = 0; file < dataset.fileList.size ( ); file++ )
     {
+        corpus->fileStarts.push_back ( (uint32_t)corpus->fileLookUp.size ( ) );
+
         for ( int timepoint = 0; timepoint < dataset.trails.raw[file].size ( ); timepoint++ )
         {
-            mCorpusFileLookUp.push_back ( file );
-            mCorpusTimeLookUp.push_back ( timepoint );
+            corpus->fileLookUp.push_back ( file );
+            corpus->timeLookUp.push_back ( timepoint );
+
+            for ( int dimension = 0; dimension < corpus->columns.size ( ); dimension++ )
+            {
+                corpus->columns[dimension].push_back ( (float)scaledDataset.trails.raw[file][timepoint][dimension] );
+            }
         }
     }
 
-    std::vector<int> tempVector;
-    
-    mDatasetConversion.CorpusToFluid ( mFullFluidSet, scaledDataset, tempVector );
+    mCorpus = corpus;
 
+    StartTrainThread ( );
     AddListeners ( );
 }
 
@@ -68,20 +79,25 @@ void Explorer::PointPicker::Clear ( )
 {
     std::lock_guard<std::mutex> lock ( mPointPickerMutex );
 
-    mFullFluidSet = fluid::FluidDataSet<std::string, double, 1> ( 0 );
-    mLiveFluidSet = fluid::FluidDataSet<std::string, double, 1> ( 0 );
+    {
+        // discards any build still running, it was for the old corpus
+        std::lock_guard<std::mutex> trainLock ( mTrainMutex );
+        mTrainGeneration++;
+        bTrainPending = false;
+        mTrainRequest = { };
+        mSearchIndex.Publish ( nullptr );
+    }
+    mCorpus.reset ( );
 
     bTrained = false; bSkipTraining = true;
     b3D = true; bPicker = false; bClicked = false; bNearestMouseCheckNeeded = false;
 
     bDimensionsFilled[0] = false; bDimensionsFilled[1] = false; bDimensionsFilled[2] = false;
     mDimensionsIndices[0] = -1; mDimensionsIndices[1] = -1; mDimensionsIndices[2] = -1;
+    mJumpDimensions.clear ( ); // corpus specific, unlike bJumpAllDimensions
 
     mNearestPoint = -1; mNearestDistance = -1; mNearestPointFile = -1; mNearestPointTime = -1;
 
-    mCorpusFileLookUp.clear ( );
-    mCorpusTimeLookUp.clear ( );
-
     RemoveListeners ( );
 }
 
@@ -95,7 +111,15 @@ void Explorer::PointPicker::Train ( int dimensionIndex, Utilities::Axis axis, bo
     else { return; }
 
     int dimsFilled = bDimensionsFilled[0] + bDimensionsFilled[1] + bDimensionsFilled[2];
-    if ( dimsFilled < 2 ) { bTrained = false; return; }
+    if ( dimsFilled < 2 )
+    {
+        std::lock_guard<std::mutex> trainLock ( mTrainMutex );
+        mTrainGeneration++;
+        bTrainPending = false;
+        bTrained = false;
+        mSearchIndex.Publish ( nullptr );
+        return;
+    }
 
     // TODO - take a closer look at this later.
     // it seems like this makes bSkipTraining get set to false once when a corpus is first opened, as it gets 3 Train calls, for the X, Y, and Z dimensions.
@@ -103,45 +127,201 @@ void Explorer::PointPicker::Train ( int dimensionIndex, Utilities::Axis axis, bo
     // and if i ever accidentally set bSkipTraining back to true anywhere other than when loading a new corpus, this could just break training
     // split this function into Train and SetDimension? - call SetDimension when first loading, then Train only once and then at runtime when changes are applied to the corpus?
     if ( axis == Utilities::Axis::Z ) { bSkipTraining = false; }
-    if ( bSkipTraining ) { return; }
 
-    mLiveFluidSet = fluid::FluidDataSet<std::string, double, 1> ( dimsFilled );
+    QueueTrain ( );
+
+    if ( dimsFilled == 2 ) { b3D = false; }
+    if ( dimsFilled == 3 ) { b3D = true; }
+}
+
+void Explorer::PointPicker::SetJumpAllDimensions ( bool all )
+{
+    std::lock_guard<std::mutex> lock ( mPointPickerMutex );
+    if ( bJumpAllDimensions == all ) { return; }
+    bJumpAllDimensions = all;
+    QueueTrain ( );
+}
+
+void Explorer::PointPicker::SetJumpDimensions ( const std::vector<int>& dimensions )
+{
+    std::lock_guard<std::mutex> lock ( mPointPickerMutex );
+    mJumpDimensions = dimensions;
+    QueueTrain ( );
+}
+
+void Explorer::PointPicker::QueueTrain ( )
+{
+    int dimsFilled = bDimensionsFilled[0] + bDimensionsFilled[1] + bDimensionsFilled[2];
+    if ( bSkipTraining || !mCorpus || dimsFilled < 2 ) { return; }
+
+    TrainRequest request;
+    request.corpus = mCorpus;
+    request.dimensionCount = dimsFilled;
+    for ( int axisIndex = 0, dim = 0; axisIndex < 3; axisIndex++ )
+    {
+        request.dimensionsFilled[axisIndex] = bDimensionsFilled[axisIndex];
+        request.liveDimensions[axisIndex] = -1;
+        if ( bDimensionsFilled[axisIndex] ) { request.liveDimensions[dim++] = mDimensionsIndices[axisIndex]; }
+    }
 
-    for ( int point = 0; point < mFullFluidSet.size ( ); point++ )
+    if ( bJumpAllDimensions )
+    {
+        for ( int dimension = 0; dimension < (int)mCorpus->columns.size ( ); dimension++ ) { request.jumpDimensions.push_back ( dimension ); }
+    }
+    else
     {
-        fluid::RealVector pointData ( dimsFilled );
-        if ( dimsFilled == 3 || bDimensionsFilled[2] == false )
+        for ( int dimension : mJumpDimensions )
         {
-            for ( int dim = 0; dim < dimsFilled; dim++ )
-            {
-                pointData[dim] = mFullFluidSet.get ( mFullFluidSet.getIds ( )[point] )[mDimensionsIndices[dim]];
-            }
+            if ( dimension >= 0 && dimension < (int)mCorpus->columns.size ( ) ) { request.jumpDimensions.push_back ( dimension ); }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> trainLock ( mTrainMutex );
+        mTrainRequest = request;
+        mTrainGeneration++;
+        bTrainPending = true;
+    }
+    mTrainCondition.notify_one ( );
+}
+
+void Explorer::PointPicker::StartTrainThread ( )
+{
+    if ( mTrainThread.joinable ( ) ) { return; }
+
+    bTrainThreadExit = false;
+    mTrainThread = std::thread ( &PointPicker::TrainThreadLoop, this );
+}
+
+void Explorer::PointPicker::StopTrainThread ( )
+{
+    if ( !mTrainThread.joinable ( ) ) { return; }
+
+    {
+        std::lock_guard<std::mutex> trainLock ( mTrainMutex );
+        bTrainThreadExit = true;
+    }
+    mTrainCondition.notify_one ( );
+    mTrainThread.join ( );
+}
+
+void Explorer::PointPicker::TrainThreadLoop ( )
+{
+    while ( true )
+    {
+        TrainRequest request;
+        uint64_t generation;
+        {
+            std::unique_lock<std::mutex> trainLock ( mTrainMutex );
+            mTrainCondition.wait ( trainLock, [this] { return bTrainPending || bTrainThreadExit; } );
+            if ( bTrainThreadExit ) { return; }
+
+            request = mTrainRequest;
+            generation = mTrainGeneration;
+            bTrainPending = false;
         }
-        else if ( bDimensionsFilled[1] == false )
+
+        ofLogNotice ( "PointPicker" ) << "Training KDTree...";
+        std::unique_ptr<SearchIndex> index = BuildSearchIndex ( request );
+
         {
-            pointData[0] = mFullFluidSet.get ( mFullFluidSet.getIds ( )[point] )[mDimensionsIndices[0]];
-            pointData[1] = mFullFluidSet.get ( mFullFluidSet.getIds ( )[point] )[mDimensionsIndices[2]];
+            // a newer request or a Clear arrived while building, this index is already out of date
+            std::lock_guard<std::mutex> trainLock ( mTrainMutex );
+            if ( generation != mTrainGeneration ) { continue; }
+
+            mSearchIndex.Publish ( std::move ( index ) );
+            bTrained = true;
         }
-        else if ( bDimensionsFilled[0] == false )
+        ofLogVerbose ( "PointPicker" ) << "KDTree Trained.";
+    }
+}
+
+std::unique_ptr<Explorer::PointPicker::SearchIndex> Explorer::PointPicker::BuildSearchIndex ( const TrainRequest& request )
+{
+    const ScaledCorpus& corpus = *request.corpus;
+    size_t pointCount = corpus.fileLookUp.size ( );
+
+    // a 2D space leaves z at 0
+    std::vector<glm::vec3> livePoints ( pointCount, glm::vec3 ( 0.0f, 0.0f, 0.0f ) );
+    std::vector<uint32_t> pointIndices ( pointCount );
+
+    for ( int dim = 0; dim < request.dimensionCount; dim++ )
+    {
+        const std::vector<float>& column = corpus.columns[request.liveDimensions[dim]];
+        for ( size_t point = 0; point < pointCount; point++ ) { livePoints[point][dim] = column[point]; }
+    }
+    for ( size_t point = 0; point < pointCount; point++ ) { pointIndices[point] = (uint32_t)point; }
+
+    auto index = std::make_unique<SearchIndex> ( );
+    index->tree.Build ( livePoints, pointIndices );
+    index->b3D = request.dimensionCount == 3;
+    for ( int axisIndex = 0; axisIndex < 3; axisIndex++ ) { index->dimensionsFilled[axisIndex] = request.dimensionsFilled[axisIndex]; }
+    index->corpus = request.corpus;
+    for ( int dim = 0; dim < 3; dim++ ) { index->liveDimensions[dim] = request.liveDimensions[dim]; }
+    index->dimensionCount = request.dimensionCount;
+
+    bool descriptorJumps = !request.jumpDimensions.empty ( );
+    if ( descriptorJumps )
+    {
+        size_t dimensions = request.jumpDimensions.size ( );
+        float scale = 1.0f / std::sqrt ( (float)dimensions );
+
+        std::vector<float> rows ( pointCount * dimensions );
+        for ( size_t dim = 0; dim < dimensions; dim++ )
         {
-            pointData[0] = mFullFluidSet.get ( mFullFluidSet.getIds ( )[point] )[mDimensionsIndices[1]];
-            pointData[1] = mFullFluidSet.get ( mFullFluidSet.getIds ( )[point] )[mDimensionsIndices[2]];
+            const std::vector<float>& column = corpus.columns[request.jumpDimensions[dim]];
+            for ( size_t point = 0; point < pointCount; point++ ) { rows[point * dimensions + dim] = column[point] * scale; }
         }
 
-        mLiveFluidSet.add ( mFullFluidSet.getIds ( )[point], pointData );
+        index->descriptors.Build ( std::move ( rows ), dimensions );
     }
 
-    ofLogNotice ( "PointPicker" ) << "Training KDTree...";
-    mKDTree = fluid::algorithm::KDTree ( mLiveFluidSet );
-    ofLogVerbose ( "PointPicker" ) << "KDTree Trained.";
-    bTrained = true;
+    // every point's nearest neighbours, so jumps never have to search
+    std::vector<uint32_t> found ( pointCount );
+    index->jumpCandidates.resize ( pointCount * kMaxJumpTargets );
 
-    if ( dimsFilled == 2 ) { b3D = false; }
-    if ( dimsFilled == 3 ) { b3D = true; }
+#pragma omp parallel
+    {
+        Utilities::HNSWIndex::Scratch scratch;
+        Utilities::HNSWIndex::Result neighbours[kMaxJumpTargets];
+        if ( descriptorJumps ) { scratch.Prepare ( index->descriptors, kJumpSearchEf ); }
+
+#pragma omp for
+        for ( long point = 0; point < (long)pointCount; point++ )
+        {
+            Utilities::PointKDTree::Result* candidates = &index->jumpCandidates[point * kMaxJumpTargets];
+
+            if ( !descriptorJumps )
+            {
+                found[point] = (uint32_t)index->tree.KNearest ( livePoints[point], kMaxJumpTargets, 0.0f, candidates );
+                continue;
+            }
+
+            found[point] = (uint32_t)index->descriptors.Search ( index->descriptors.GetPoint ( point ), kMaxJumpTargets, kJumpSearchEf, scratch, neighbours );
+            for ( uint32_t i = 0; i < found[point]; i++ ) { candidates[i] = { neighbours[i].payload, neighbours[i].distance }; }
+        }
+    }
+
+    // close the gaps left by points with fewer neighbours than kMaxJumpTargets (only in tiny corpora)
+    index->jumpOffsets.resize ( pointCount + 1 );
+    size_t edges = 0;
+    for ( size_t point = 0; point < pointCount; point++ )
+    {
+        index->jumpOffsets[point] = (uint32_t)edges;
+        for ( uint32_t candidate = 0; candidate < found[point]; candidate++ )
+        {
+            index->jumpCandidates[edges++] = index->jumpCandidates[point * kMaxJumpTargets + candidate];
+        }
+    }
+    index->jumpOffsets[pointCount] = (uint32_t)edges;
+    index->jumpCandidates.resize ( edges );
+
+    return index;
 }
 
 void Explorer::PointPicker::Exit ( )
 {
+    StopTrainThread ( );
     RemoveListeners ( );
 }
 
@@ -194,16 +374,10 @@ void Explorer::PointPicker::Draw ( )
         ofEnableDepthTest ( );
         mCamera->begin ( );
 
-        ofSetColor ( 150, 150, 255, 125 );
-        for ( int i = 0; i < testPoints.size ( ); i++ )
-        {
-            ofDrawSphere ( testPoints[i], testRadii[i] );
-        }
-
-        ofSetColor ( 255, 255, 255, 25 );
-        for ( int i = 0; i < testPointsOutOfRange.size ( ); i++ )
+        if ( b3D )
         {
-            ofDrawSphere ( testPointsOutOfRange[i], testRadiiOutOfRange[i] );
+            ofSetColor ( 150, 150, 255, 125 );
+            ofDrawLine ( mDebugRayStart, mDebugRayEnd );
         }
 
         mCamera->end ( );
@@ -213,216 +387,321 @@ void Explorer::PointPicker::Draw ( )
 
 void Explorer::PointPicker::FindNearestToMouse ( )
 {
-    if ( !bClicked ) { return; }
-    bClicked = false;
+    mSearchIndex.Reclaim ( ); // frees indexes replaced by Train once the audio thread has moved on from them
 
-    if ( !bPicker && !bTrained && !bNearestMouseCheckNeeded ) { return; }
+    // a right click always picks, with the picker toggled on the pick follows the mouse
+    if ( !bTrained ) { return; }
+    if ( !bClicked && !( bPicker && bNearestMouseCheckNeeded ) ) { return; }
+    bClicked = false;
     bNearestMouseCheckNeeded = false;
 
     std::lock_guard<std::mutex> lock ( mPointPickerMutex );
 
+    auto index = mSearchIndex.Read ( );
+    if ( !index ) { return; }
+
     mNearestPoint = -1; mNearestPointFile = -1; mNearestPointTime = -1;
     mNearestDistance = std::numeric_limits<double>::max ( );
 
     int mouseX = ofGetMouseX ( );
     int mouseY = ofGetMouseY ( );
 
-    if ( !b3D )
+    if ( !index->b3D )
     {
         // 2D nearest
 
         glm::vec3 rayPosition = mCamera->screenToWorld ( glm::vec3 ( mouseX, mouseY, 0 ) );
         glm::vec2 rayPosition2D;
         
-        if ( !bDimensionsFilled[0] ) { rayPosition2D.x = rayPosition.y; rayPosition2D.y = rayPosition.z; rayPosition.x = 0; }
-        if ( !bDimensionsFilled[1] ) { rayPosition2D.x = rayPosition.x; rayPosition2D.y = rayPosition.z; rayPosition.y = 0; }
-        if ( !bDimensionsFilled[2] ) { rayPosition2D.x = rayPosition.x; rayPosition2D.y = rayPosition.y; rayPosition.z = 0; }
-
-        fluid::RealVector query ( 2 );
+        if ( !index->dimensionsFilled[0] ) { rayPosition2D.x = rayPosition.y; rayPosition2D.y = rayPosition.z; rayPosition.x = 0; }
+        if ( !index->dimensionsFilled[1] ) { rayPosition2D.x = rayPosition.x; rayPosition2D.y = rayPosition.z; rayPosition.y = 0; }
+        if ( !index->dimensionsFilled[2] ) { rayPosition2D.x = rayPosition.x; rayPosition2D.y = rayPosition.y; rayPosition.z = 0; }
 
-        query[0] = ofMap ( rayPosition2D.x, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false );
-        query[1] = ofMap ( rayPosition2D.y, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false );
+        glm::vec3 query ( ofMap ( rayPosition2D.x, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false ),
+                          ofMap ( rayPosition2D.y, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false ),
+                          0.0f );
 
         double maxAllowedDistance = ofMap ( mCamera->getScale ( ).x, SpaceDefs::mZoomMin2D, SpaceDefs::mZoomMax2D, maxAllowedDistanceNear * 1.5, maxAllowedDistanceFar * 1.5 );
 
-        auto [dist, id] = mKDTree.kNearest ( query, 1, maxAllowedDistance );
+        Utilities::PointKDTree::Result nearest;
+        if ( index->tree.KNearest ( query, 1, (float)maxAllowedDistance, &nearest ) == 0 ) { return; }
 
-        if ( dist.size ( ) == 0 ) { return; }
-
-        if ( dist[0] < mNearestDistance )
+        if ( nearest.distance < mNearestDistance )
         {
-            mNearestDistance = dist[0];
-            mNearestPoint = std::stoi ( *id[0] );
-            mNearestPointFile = mCorpusFileLookUp[mNearestPoint];
-            mNearestPointTime = mCorpusTimeLookUp[mNearestPoint];
+            mNearestDistance = nearest.distance;
+            mNearestPoint = (int)nearest.payload;
+            mNearestPointFile = index->corpus->fileLookUp[mNearestPoint];
+            mNearestPointTime = index->corpus->timeLookUp[mNearestPoint];
         }
 
         return;
     }
 
-    // 3D nearest
-    
-    double desiredRayLength = 15000.0f;
-    double rayLength = 0.0f;
-    std::vector<double> rayPointSpacing;
-    
-    do
-    {
-        double maxAllowedDistance = ofMap ( rayLength, 0.0f, desiredRayLength, 0.01, 0.05, false );
-        rayPointSpacing.push_back ( maxAllowedDistance );
-        rayLength += maxAllowedDistance * ( SpaceDefs::mSpaceMax - SpaceDefs::mSpaceMin );
-    } while ( rayLength < desiredRayLength );
+    // 3D nearest - one traversal of the tree along the mouse ray, accepting points inside a cone that widens with depth
 
+    glm::vec3 cameraPosition = mCamera->getPosition ( );
     glm::vec3 rayDirection = mCamera->screenToWorld ( glm::vec3 ( (float)mouseX, (float)mouseY, 0.0f ) );
-    rayDirection = glm::normalize ( rayDirection - mCamera->getPosition ( ) );
-    double depth = 0.0f;
+    rayDirection = glm::normalize ( rayDirection - cameraPosition );
+
+    double spaceSize = SpaceDefs::mSpaceMax - SpaceDefs::mSpaceMin;
+    float rayLength = (float)( mDesiredRayLength / spaceSize );
+    float radiusPerLength = (float)( ( maxAllowedDistanceFar - maxAllowedDistanceNear ) / rayLength );
+
+    glm::vec3 rayOrigin ( ofMap ( cameraPosition.x, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false ),
+                          ofMap ( cameraPosition.y, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false ),
+                          ofMap ( cameraPosition.z, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false ) );
+
+    if ( bDebug )
+    {
+        mDebugRayStart = cameraPosition;
+        mDebugRayEnd = cameraPosition + rayDirection * (float)mDesiredRayLength;
+    }
+
+    Utilities::PointKDTree::Result nearest;
+    if ( !index->tree.RayNearest ( rayOrigin, rayDirection, rayLength, (float)maxAllowedDistanceNear, radiusPerLength, nearest ) ) { return; }
+
+    mNearestDistance = nearest.distance;
+    mNearestPoint = (int)nearest.payload;
+    mNearestPointFile = index->corpus->fileLookUp[mNearestPoint];
+    mNearestPointTime = index->corpus->timeLookUp[mNearestPoint];
+}
+
+void Explorer::PointPicker::FindJumpTargets ( const JumpQuery* queries, size_t count, const Utilities::AudioData& audioSet, size_t hopSize, AudioCache* audioCache,
+                                              Utilities::HNSWIndex::Scratch& scratch, Utilities::PointFT* targets, bool* found )
+{
+    std::fill ( found, found + count, false );
+
+    auto index = mSearchIndex.Read ( );
+    if ( !index ) { return; }
 
-    testPoints.clear ( );
-    testRadii.clear ( );
-    testPointsOutOfRange.clear ( );
-    testRadiiOutOfRange.clear ( );
+    if ( !index->descriptors.Empty ( ) && !scratch.IsPreparedFor ( index->descriptors, kJumpSearchEf ) ) { scratch.Prepare ( index->descriptors, kJumpSearchEf ); }
 
-    for ( int rayPoint = 1; rayPoint < rayPointSpacing.size ( ); rayPoint++ )
+    std::vector<PendingJumpSearch> pending;
+
+    for ( size_t i = 0; i < count; i++ )
     {
-        depth += rayPointSpacing[rayPoint] * ( SpaceDefs::mSpaceMax - SpaceDefs::mSpaceMin );
+        const JumpQuery& query = queries[i];
+        if ( query.maxAllowedDistanceSpaceX1000 == 0 ) { continue; }
 
-        glm::vec3 rayPointPosition = mCamera->getPosition ( ) + glm::vec3 ( rayDirection.x * depth,
-                                                                            rayDirection.y * depth, 
-                                                                            rayDirection.z * depth );
+        size_t point;
+        if ( !LookUpIndexPoint ( *index->corpus, query.currentPoint, point ) ) { continue; }
 
-        if ( rayPointPosition.x < ( SpaceDefs::mSpaceMin - 250 ) || rayPointPosition.x > ( SpaceDefs::mSpaceMax + 250 ) ||
-            rayPointPosition.y < ( SpaceDefs::mSpaceMin - 250 ) || rayPointPosition.y > ( SpaceDefs::mSpaceMax + 250 ) ||
-            rayPointPosition.z < ( SpaceDefs::mSpaceMin - 250 ) || rayPointPosition.z > ( SpaceDefs::mSpaceMax + 250 ) )
-        {
-            if ( bDebug )
-            {
-                testPointsOutOfRange.push_back ( rayPointPosition );
-                testRadiiOutOfRange.push_back ( rayPointSpacing[rayPoint] * ( SpaceDefs::mSpaceMax - SpaceDefs::mSpaceMin ) );
-            }
-            continue; 
-        }
+        JumpRules rules { query.currentPoint, query.sameFileAllowed, query.minTimeDiffSameFile, query.remainingSamplesRequired, &audioSet, hopSize, audioCache };
+        float maxAllowedDistanceSpace = (float)query.maxAllowedDistanceSpaceX1000 / 1000.0f;
+        bool missingFileRequested = false;
 
-        if ( bDebug )
+        GraphJump graphJump = TryJumpGraph ( *index, point, query.maxAllowedTargets, maxAllowedDistanceSpace, rules, missingFileRequested, targets[i] );
+        if ( graphJump != GraphJump::Unresolved ) { found[i] = graphJump == GraphJump::Found; continue; }
+
+        // the descriptor index has no batched search, those go one at a time
+        if ( !index->descriptors.Empty ( ) )
         {
-            testPoints.push_back ( rayPointPosition );
-            testRadii.push_back ( rayPointSpacing[rayPoint] * (SpaceDefs::mSpaceMax - SpaceDefs::mSpaceMin) );
+            found[i] = SearchJumpTarget ( *index, glm::vec3 ( ), index->descriptors.GetPoint ( point ), maxAllowedDistanceSpace, rules, !missingFileRequested, scratch, targets[i] );
+            continue;
         }
 
-        fluid::RealVector query ( 3 );
+        glm::vec3 position = GetIndexPosition ( *index, (uint32_t)point );
+        pending.push_back ( { i, MortonOrder ( position ), position, maxAllowedDistanceSpace, rules, !missingFileRequested } );
+    }
 
-        query[0] = ofMap ( rayPointPosition.x, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false );
-        query[1] = ofMap ( rayPointPosition.y, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false );
-        query[2] = ofMap ( rayPointPosition.z, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false );
+    if ( pending.empty ( ) ) { return; }
 
-        auto [dist, id] = mKDTree.kNearest ( query, 1, rayPointSpacing[rayPoint] );
+    std::sort ( pending.begin ( ), pending.end ( ), [] ( const PendingJumpSearch& a, const PendingJumpSearch& b ) { return a.order < b.order; } );
 
-        if ( dist.size ( ) == 0 ) { continue; }
+    // a shared walk only pays off when the queries would visit mostly the same nodes anyway,
+    // so packets only grow while their spread stays within the search distance, queries left on their own search alone
+    size_t begin = 0;
+    while ( begin < pending.size ( ) )
+    {
+        glm::vec3 low = pending[begin].position;
+        glm::vec3 high = pending[begin].position;
+        float reach = pending[begin].maxDistance;
+        size_t end = begin + 1;
 
-        if ( dist[0] < mNearestDistance )
+        while ( end < pending.size ( ) && end - begin < Utilities::PointKDTree::kMaxBatch )
+        {
+            glm::vec3 packetLow = glm::min ( low, pending[end].position );
+            glm::vec3 packetHigh = glm::max ( high, pending[end].position );
+            glm::vec3 spread = packetHigh - packetLow;
+            float packetReach = std::min ( reach, pending[end].maxDistance );
+            if ( std::max ( spread.x, std::max ( spread.y, spread.z ) ) > packetReach ) { break; }
+
+            low = packetLow;
+            high = packetHigh;
+            reach = packetReach;
+            end++;
+        }
+
+        if ( end - begin == 1 )
+        {
+            const PendingJumpSearch& search = pending[begin];
+            found[search.query] = SearchJumpTarget ( *index, search.position, nullptr, search.maxDistance, search.rules, search.requestMissing, scratch, targets[search.query] );
+        }
+        else
         {
-            mNearestDistance = dist[0];
-            mNearestPoint = std::stoi ( *id[0] );
-            mNearestPointFile = mCorpusFileLookUp[mNearestPoint];
-            mNearestPointTime = mCorpusTimeLookUp[mNearestPoint];
+            SearchJumpPacket ( *index, &pending[begin], end - begin, targets, found );
         }
+
+        begin = end;
     }
 }
 
-// TODO - revisit this function for any performance improvements
-bool Explorer::PointPicker::FindNearestToPosition ( const glm::vec3& position, Utilities::PointFT& nearestPoint, Utilities::PointFT currentPoint, 
-                                                    int maxAllowedDistanceSpaceX1000, int maxAllowedTargets, bool sameFileAllowed,
-                                                    int minTimeDiffSameFile, int remainingSamplesRequired, const Utilities::AudioData& audioSet, size_t hopSize )
+bool Explorer::PointPicker::LookUpIndexPoint ( const ScaledCorpus& corpus, Utilities::PointFT point, size_t& indexPoint )
 {
-    if ( !bTrained ) { return false; }
+    if ( point.file >= corpus.fileStarts.size ( ) ) { return false; }
 
-    if ( maxAllowedDistanceSpaceX1000 == 0 ) { return false; }
+    indexPoint = corpus.fileStarts[point.file] + point.time;
+    return indexPoint < corpus.fileLookUp.size ( ) && corpus.fileLookUp[indexPoint] == (int)point.file;
+}
 
-    if ( mPointPickerMutex.try_lock ( ) )
-    {
-        std::lock_guard<std::mutex> lock ( mPointPickerMutex, std::adopt_lock );
+Explorer::PointPicker::GraphJump Explorer::PointPicker::TryJumpGraph ( const SearchIndex& index, size_t point, int maxAllowedTargets, float maxDistance, const JumpRules& rules,
+                                                                       bool& missingFileRequested, Utilities::PointFT& nearestPoint )
+{
+    const ScaledCorpus& corpus = *index.corpus;
+
+    // candidates are sorted, so the first valid one is the nearest valid target overall
+    // the neighbours are usually the playhead's own file a hop or two away, if those are all ruled out the index is searched with the same rules
+    size_t first = index.jumpOffsets[point];
+    size_t last = std::min ( (size_t)index.jumpOffsets[point + 1], first + (size_t)std::clamp ( maxAllowedTargets, 1, kMaxJumpTargets ) );
 
-        double maxAllowedDistanceSpace = (double)maxAllowedDistanceSpaceX1000 / 1000.0;
+    for ( size_t candidate = first; candidate < last; candidate++ )
+    {
+        const Utilities::PointKDTree::Result& target = index.jumpCandidates[candidate];
+        if ( target.distance > maxDistance ) { return GraphJump::OutOfRange; } // nothing further can be in range either
 
-        if ( !b3D )
+        JumpCheck check = CheckJumpTarget ( corpus, target.payload, rules );
+        if ( check == JumpCheck::NotResident && DEFAULT_AUDIO_CACHE_JUMP_REQUESTS_MISSING && !missingFileRequested ) // load the nearest miss for next time
         {
-            // 2D nearest
+            rules.audioCache->RequestLoad ( corpus.fileLookUp[target.payload], true );
+            missingFileRequested = true;
+        }
+        if ( check != JumpCheck::Valid ) { continue; }
 
-            glm::vec2 position2D;
+        nearestPoint.file = corpus.fileLookUp[target.payload];
+        nearestPoint.time = corpus.timeLookUp[target.payload];
+        return GraphJump::Found;
+    }
 
-            if ( !bDimensionsFilled[0] ) { position2D.x = position.y; position2D.y = position.z; }
-            if ( !bDimensionsFilled[1] ) { position2D.x = position.x; position2D.y = position.z; }
-            if ( !bDimensionsFilled[2] ) { position2D.x = position.x; position2D.y = position.y; }
+    return GraphJump::Unresolved;
+}
 
-            fluid::RealVector query ( 2 );
+bool Explorer::PointPicker::SearchJumpTarget (  const SearchIndex& index, const glm::vec3& position, const float* descriptorQuery, float maxDistance,
+                                                const JumpRules& rules, bool requestMissing, Utilities::HNSWIndex::Scratch& scratch, Utilities::PointFT& nearestPoint )
+{
+    const ScaledCorpus& corpus = *index.corpus;
 
-            query[0] = ofMap ( position2D.x, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false );
-            query[1] = ofMap ( position2D.y, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false );
+    Utilities::PointKDTree::Result missed { 0, std::numeric_limits<float>::max ( ) };
+    auto accept = [&] ( uint32_t point, float distance )
+    {
+        JumpCheck check = CheckJumpTarget ( corpus, point, rules );
+        if ( check == JumpCheck::NotResident && distance < missed.distance ) { missed = { point, distance }; }
+        return check == JumpCheck::Valid;
+    };
+
+    Utilities::PointKDTree::Result result;
+    bool found = false;
+    if ( descriptorQuery != nullptr )
+    {
+        Utilities::HNSWIndex::Result descriptorResult;
+        found = index.descriptors.SearchMatching ( descriptorQuery, kJumpSearchEf, maxDistance, kJumpSearchMaxVisits, accept, scratch, descriptorResult );
+        result = { descriptorResult.payload, descriptorResult.distance };
+    }
+    else
+    {
+        found = index.tree.NearestMatching ( position, maxDistance, accept, result );
+    }
 
-            auto [dist, id] = mKDTree.kNearest ( query, maxAllowedTargets, maxAllowedDistanceSpace );
+    return FinishJumpSearch ( corpus, found, result, missed, rules, requestMissing, nearestPoint );
+}
 
-            if ( dist.size ( ) == 0 ) { return false; }
+void Explorer::PointPicker::SearchJumpPacket ( const SearchIndex& index, const PendingJumpSearch* packet, size_t count, Utilities::PointFT* targets, bool* found )
+{
+    const ScaledCorpus& corpus = *index.corpus;
 
-            double nearestDistance = std::numeric_limits<double>::max ( );
-            bool jumpFound = false;
-            
-            for ( int i = 0; i < dist.size ( ); i++ )
-            {
-                if ( dist[i] < nearestDistance )
-                {
-                    int point = std::stoi ( *id[i] );
-                    if ( !sameFileAllowed && mCorpusFileLookUp[point] == currentPoint.file ) { continue; } // skip if jumping would jump to the same file and the option is not allowed
-                    size_t timeDiff = mCorpusTimeLookUp[point] > currentPoint.time ? mCorpusTimeLookUp[point] - currentPoint.time : currentPoint.time - mCorpusTimeLookUp[point];
-                    if ( sameFileAllowed && mCorpusFileLookUp[point] == currentPoint.file && timeDiff < minTimeDiffSameFile ) { continue; } // skip if jumping would jump to the same file and the time difference is too small
-
-                    if ( audioSet.raw[mCorpusFileLookUp[point]].getNumFrames ( ) - ( (size_t)mCorpusTimeLookUp[point] * hopSize ) < remainingSamplesRequired ) { continue; } // skip if there's not enough samples left in the file
-
-                    nearestDistance = dist[i];
-                    nearestPoint.file = mCorpusFileLookUp[point];
-                    nearestPoint.time = mCorpusTimeLookUp[point];
-                    jumpFound = true;
-                }
-            }
+    glm::vec3 positions[Utilities::PointKDTree::kMaxBatch];
+    float maxDistances[Utilities::PointKDTree::kMaxBatch];
+    Utilities::PointKDTree::Result results[Utilities::PointKDTree::kMaxBatch];
+    Utilities::PointKDTree::Result missed[Utilities::PointKDTree::kMaxBatch];
+    bool packetFound[Utilities::PointKDTree::kMaxBatch];
 
-            return jumpFound;
-        }
+    for ( size_t lane = 0; lane < count; lane++ )
+    {
+        positions[lane] = packet[lane].position;
+        maxDistances[lane] = packet[lane].maxDistance;
+        missed[lane] = { 0, std::numeric_limits<float>::max ( ) };
+    }
 
-        // 3D nearest
+    auto accept = [&] ( size_t lane, uint32_t point, float distance )
+    {
+        JumpCheck check = CheckJumpTarget ( corpus, point, packet[lane].rules );
+        if ( check == JumpCheck::NotResident && distance < missed[lane].distance ) { missed[lane] = { point, distance }; }
+        return check == JumpCheck::Valid;
+    };
 
-        fluid::RealVector query ( 3 );
+    index.tree.NearestMatchingBatch ( positions, maxDistances, count, accept, results, packetFound );
 
-        query[0] = ofMap ( position.x, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false );
-        query[1] = ofMap ( position.y, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false );
-        query[2] = ofMap ( position.z, SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false );
+    for ( size_t lane = 0; lane < count; lane++ )
+    {
+        const PendingJumpSearch& search = packet[lane];
+        found[search.query] = FinishJumpSearch ( corpus, packetFound[lane], results[lane], missed[lane], search.rules, search.requestMissing, targets[search.query] );
+    }
+}
 
-        auto [dist, id] = mKDTree.kNearest ( query, maxAllowedTargets, maxAllowedDistanceSpace );
+bool Explorer::PointPicker::FinishJumpSearch (  const ScaledCorpus& corpus, bool found, const Utilities::PointKDTree::Result& result,
+                                                const Utilities::PointKDTree::Result& missed, const JumpRules& rules, bool requestMissing,
+                                                Utilities::PointFT& nearestPoint )
+{
+    // skipped for not being in memory, but nearer than the target, so load it for next time
+    if ( DEFAULT_AUDIO_CACHE_JUMP_REQUESTS_MISSING && requestMissing && rules.audioCache != nullptr &&
+         missed.distance != std::numeric_limits<float>::max ( ) && ( !found || missed.distance < result.distance ) )
+    {
+        rules.audioCache->RequestLoad ( corpus.fileLookUp[missed.payload], true );
+    }
 
-        if ( dist.size ( ) == 0 ) { return false; }
+    if ( !found ) { return false; }
 
-        double nearestDistance = std::numeric_limits<double>::max ( );
-        bool jumpFound = false;
+    nearestPoint.file = corpus.fileLookUp[result.payload];
+    nearestPoint.time = corpus.timeLookUp[result.payload];
+    return true;
+}
 
-        for ( int i = 0; i < dist.size ( ); i++ )
-        {
-            if ( dist[i] < nearestDistance )
-            {
-                int point = std::stoi ( *id[i] );
-                if ( !sameFileAllowed && mCorpusFileLookUp[point] == currentPoint.file ) { continue; } // skip if jumping would jump to the same file and the option is not allowed
-                size_t timeDiff = mCorpusTimeLookUp[point] > currentPoint.time ? mCorpusTimeLookUp[point] - currentPoint.time : currentPoint.time - mCorpusTimeLookUp[point];
-                if ( sameFileAllowed && mCorpusFileLookUp[point] == currentPoint.file && timeDiff < minTimeDiffSameFile ) { continue; } // skip if jumping would jump to the same file and the time difference is too small
+uint32_t Explorer::PointPicker::MortonOrder ( const glm::vec3& position )
+{
+    // 10 bits per axis, interleaved
+    auto spread = [] ( float value )
+    {
+        uint32_t bits = (uint32_t)std::clamp ( value * 1023.0f, 0.0f, 1023.0f );
+        bits = ( bits | ( bits << 16 ) ) & 0x030000FF;
+        bits = ( bits | ( bits << 8 ) ) & 0x0300F00F;
+        bits = ( bits | ( bits << 4 ) ) & 0x030C30C3;
+        bits = ( bits | ( bits << 2 ) ) & 0x09249249;
+        return bits;
+    };
+
+    return spread ( position.x ) | ( spread ( position.y ) << 1 ) | ( spread ( position.z ) << 2 );
+}
 
-                if ( audioSet.raw[mCorpusFileLookUp[point]].getNumFrames ( ) - ((size_t)mCorpusTimeLookUp[point] * hopSize) < remainingSamplesRequired ) { continue; } // skip if there's not enough samples left in the file
+Explorer::PointPicker::JumpCheck Explorer::PointPicker::CheckJumpTarget ( const ScaledCorpus& corpus, uint32_t point, const JumpRules& rules )
+{
+    size_t file = (size_t)corpus.fileLookUp[point];
+    size_t time = (size_t)corpus.timeLookUp[point];
 
-                nearestDistance = dist[i];
-                nearestPoint.file = mCorpusFileLookUp[point];
-                nearestPoint.time = mCorpusTimeLookUp[point];
-                jumpFound = true;
-            }
+    if ( !rules.sameFileAllowed && file == rules.currentPoint.file ) { return JumpCheck::Invalid; } // jumping would jump to the same file and the option is not allowed
+    size_t timeDiff = time > rules.currentPoint.time ? time - rules.currentPoint.time : rules.currentPoint.time - time;
+    if ( rules.sameFileAllowed && file == rules.currentPoint.file && timeDiff < rules.minTimeDiffSameFile ) { return JumpCheck::Invalid; } // jumping would jump to the same file and the time difference is too small
 
-            return jumpFound;
-        }
-    }
+    if ( rules.audioSet->length[file] - ( time * rules.hopSize ) < rules.remainingSamplesRequired ) { return JumpCheck::Invalid; } // not enough samples left in the file
+
+    if ( rules.audioCache != nullptr && !rules.audioCache->IsResident ( file ) ) { return JumpCheck::NotResident; }
+
+    return JumpCheck::Valid;
+}
 
-    return false;
+glm::vec3 Explorer::PointPicker::GetIndexPosition ( const SearchIndex& index, uint32_t point )
+{
+    glm::vec3 position ( 0.0f, 0.0f, 0.0f );
+    for ( int dim = 0; dim < index.dimensionCount; dim++ ) { position[dim] = index.corpus->columns[index.liveDimensions[dim]][point]; }
+    return position;
 }
 
 void Explorer::PointPicker::FindRandom ( )
@@ -431,14 +710,168 @@ void Explorer::PointPicker::FindRandom ( )
 
     std::lock_guard<std::mutex> lock ( mPointPickerMutex );
 
-    std::uniform_int_distribution<int> dist ( 0, (int)mCorpusFileLookUp.size ( ) - 1 );
+    if ( !mCorpus || mCorpus->fileLookUp.empty ( ) ) { return; }
+
+    std::uniform_int_distribution<int> dist ( 0, (int)mCorpus->fileLookUp.size ( ) - 1 );
     int randomPoint = dist ( mRandomGen );
 
     mNearestPoint = randomPoint;
     mNearestDistance = 0.0;
 
-    mNearestPointFile = mCorpusFileLookUp[randomPoint];
-    mNearestPointTime = mCorpusTimeLookUp[randomPoint];
+    mNearestPointFile = mCorpus->fileLookUp[randomPoint];
+    mNearestPointTime = mCorpus->timeLookUp[randomPoint];
+}
+
+bool Explorer::PointPicker::SelectInBox ( const glm::vec3& corner1, const glm::vec3& corner2, Utilities::PointSelection& selection )
+{
+    auto index = mSearchIndex.Read ( );
+    if ( !index ) { selection.Resize ( 0 ); return false; }
+
+    selection.Resize ( index->corpus->fileLookUp.size ( ) );
+
+    glm::vec3 low = glm::min ( corner1, corner2 );
+    glm::vec3 high = glm::max ( corner1, corner2 );
+
+    int axes[3];
+    int axesUsed = GetDisplayAxes ( *index, axes );
+
+    // undrawn axes hold every point at 0
+    for ( int axis = 0; axis < 3; axis++ )
+    {
+        if ( axis != axes[0] && axis != axes[1] && axis != axes[2] && ( low[axis] > 0.0f || high[axis] < 0.0f ) ) { return true; }
+    }
+
+    Utilities::BoxRegion region { glm::vec3 ( 0.0f ), glm::vec3 ( 0.0f ) };
+    for ( int dim = 0; dim < axesUsed; dim++ )
+    {
+        region.minimum[dim] = ofMap ( low[axes[dim]], SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false );
+        region.maximum[dim] = ofMap ( high[axes[dim]], SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false );
+    }
+
+    index->tree.Select ( region, selection );
+    return true;
+}
+
+bool Explorer::PointPicker::SelectInSphere ( const glm::vec3& centre, float radius, Utilities::PointSelection& selection )
+{
+    auto index = mSearchIndex.Read ( );
+    if ( !index ) { selection.Resize ( 0 ); return false; }
+
+    selection.Resize ( index->corpus->fileLookUp.size ( ) );
+
+    int axes[3];
+    int axesUsed = GetDisplayAxes ( *index, axes );
+
+    // undrawn axes hold every point at 0, so the sphere is cut down to where it crosses them
+    float radiusSquared = radius * radius;
+    for ( int axis = 0; axis < 3; axis++ )
+    {
+        if ( axis != axes[0] && axis != axes[1] && axis != axes[2] ) { radiusSquared -= centre[axis] * centre[axis]; }
+    }
+    if ( radiusSquared < 0.0f ) { return true; }
+
+    Utilities::SphereRegion region { glm::vec3 ( 0.0f ), std::sqrt ( radiusSquared ) / (float)( SpaceDefs::mSpaceMax - SpaceDefs::mSpaceMin ) };
+    for ( int dim = 0; dim < axesUsed; dim++ )
+    {
+        region.centre[dim] = ofMap ( centre[axes[dim]], SpaceDefs::mSpaceMin, SpaceDefs::mSpaceMax, 0.0, 1.0, false );
+    }
+
+    index->tree.Select ( region, selection );
+    return true;
+}
+
+bool Explorer::PointPicker::SelectNearPoint ( Utilities::PointFT centrePoint, float radius, size_t maxPoints, Utilities::PointSelection& selection )
+{
+    auto index = mSearchIndex.Read ( );
+    if ( !index ) { selection.Resize ( 0 ); return false; }
+
+    selection.Resize ( index->corpus->fileLookUp.size ( ) );
+
+    size_t point;
+    if ( !LookUpIndexPoint ( *index->corpus, centrePoint, point ) ) { return true; }
+
+    std::vector<Utilities::PointKDTree::Result> nearby ( maxPoints );
+    size_t found = index->tree.Radius ( GetIndexPosition ( *index, (uint32_t)point ), radius, nearby.data ( ), maxPoints );
+    for ( size_t i = 0; i < found; i++ ) { selection.Set ( nearby[i].payload ); }
+    return true;
+}
+
+bool Explorer::PointPicker::SelectInScreenRect ( const glm::vec2& corner1, const glm::vec2& corner2, Utilities::PointSelection& selection )
+{
+    return SelectInLasso ( { corner1, glm::vec2 ( corner2.x, corner1.y ), corner2, glm::vec2 ( corner1.x, corner2.y ) }, selection );
+}
+
+bool Explorer::PointPicker::SelectInLasso ( const std::vector<glm::vec2>& lasso, Utilities::PointSelection& selection )
+{
+    auto index = mSearchIndex.Read ( );
+    if ( !index || !mCamera ) { selection.Resize ( 0 ); return false; }
+
+    selection.Resize ( index->corpus->fileLookUp.size ( ) );
+    if ( lasso.size ( ) < 3 ) { return true; }
+
+    int axes[3];
+    int axesUsed = GetDisplayAxes ( *index, axes );
+
+    // index space to the explorer's space, undrawn axes stay at 0
+    glm::mat4 indexToSpace ( 0.0f );
+    for ( int dim = 0; dim < axesUsed; dim++ )
+    {
+        indexToSpace[dim][axes[dim]] = (float)( SpaceDefs::mSpaceMax - SpaceDefs::mSpaceMin );
+        indexToSpace[3][axes[dim]] = (float)SpaceDefs::mSpaceMin;
+    }
+    indexToSpace[3][3] = 1.0f;
+
+    ofRectangle viewport = ofGetCurrentViewport ( );
+
+    Utilities::ScreenRegion region;
+    region.toClip = mCamera->getModelViewProjectionMatrix ( viewport ) * indexToSpace;
+    region.viewport = glm::vec4 ( viewport.x, viewport.y, viewport.width, viewport.height );
+    region.low = lasso[0];
+    region.high = lasso[0];
+    for ( const glm::vec2& vertex : lasso )
+    {
+        region.low = glm::min ( region.low, vertex );
+        region.high = glm::max ( region.high, vertex );
+    }
+
+    // a rectangle is tested by its bounds alone, which lets whole subtrees inside it be taken without testing their points
+    bool rectangle = lasso.size ( ) == 4 && ( ( lasso[0].x == lasso[3].x && lasso[1].x == lasso[2].x && lasso[0].y == lasso[1].y && lasso[2].y == lasso[3].y ) ||
+                                              ( lasso[0].x == lasso[1].x && lasso[2].x == lasso[3].x && lasso[0].y == lasso[3].y && lasso[1].y == lasso[2].y ) );
+    if ( !rectangle ) { region.polygon = lasso; }
+
+    index->tree.Select ( region, selection );
+    return true;
+}
+
+void Explorer::PointPicker::GetSelectedPoints ( const Utilities::PointSelection& selection, std::vector<Utilities::PointFT>& points )
+{
+    points.clear ( );
+
+    auto index = mSearchIndex.Read ( );
+    if ( !index ) { return; }
+
+    const ScaledCorpus& corpus = *index->corpus;
+    points.reserve ( selection.Count ( ) );
+    selection.ForEach ( [&] ( uint32_t point )
+    {
+        if ( point >= corpus.fileLookUp.size ( ) ) { return; }
+
+        Utilities::PointFT selected;
+        selected.file = corpus.fileLookUp[point];
+        selected.time = corpus.timeLookUp[point];
+        points.push_back ( selected );
+    } );
+}
+
+int Explorer::PointPicker::GetDisplayAxes ( const SearchIndex& index, int axes[3] )
+{
+    int used = 0;
+    for ( int axis = 0; axis < 3; axis++ )
+    {
+        axes[axis] = -1;
+        if ( index.dimensionsFilled[axis] ) { axes[used++] = axis; }
+    }
+    return used;
 }
 
 void Explorer::PointPicker::KeyEvent ( ofKeyEventArgs& args )
@@ -18,13 +18,17 @@ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 
 #include "Explorer/RawView.h"
 #include "Utilities/DimensionBounds.h"
-#include "Utilities/DatasetConversion.h"
+#include "Utilities/PointKDTree.h"
+#include "Utilities/PointSelection.h"
+#include "Utilities/HNSWIndex.h"
+#include "Utilities/SharedSnapshot.h"
 
-#include <flucoma/algorithms/public/KDTree.hpp>
-#include <flucoma/data/FluidDataSet.hpp>
 #include <ofCamera.h>
 #include <ofEvents.h>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <memory>
 #include <atomic>
 #include <random>
 
@@ -34,23 +38,49 @@ namespace Explorer {
 class PointPicker {
 public:
     PointPicker ( );
-    ~PointPicker ( ) { }
+    ~PointPicker ( ) { StopTrainThread ( ); }
 
     void Initialise ( const Utilities::DataSet& dataset, const Utilities::DimensionBounds& dimensionBounds );
     void Clear ( );
 
-    void Train ( int dimensionIndex, Utilities::Axis axis, bool none );
+    void Train ( int dimensionIndex, Utilities::Axis axis, bool none ); // the index is rebuilt in the background, the previous one keeps serving searches until then
+
+    // jump targets are found by proximity in the displayed space, unless either of these are set, then by similarity across the chosen corpus dimensions
+    void SetJumpAllDimensions ( bool all );
+    void SetJumpDimensions ( const std::vector<int>& dimensions ); // a subset, empty to clear it
 
     void Exit ( );
 
     void Draw ( );
 
     void FindNearestToMouse ( );
-    bool FindNearestToPosition (	const glm::vec3& position, Utilities::PointFT& nearestPoint, Utilities::PointFT currentPoint, 
-                                    int maxAllowedDistanceSpaceX1000, int maxAllowedTargets, bool sameFileAllowed, 
-                                    int minTimeDiffSameFile, int remainingSamplesRequired, const Utilities::AudioData& audioSet, size_t hopSize );
+    struct JumpQuery {
+        Utilities::PointFT currentPoint;
+        int maxAllowedDistanceSpaceX1000 = 0;
+        int maxAllowedTargets = 1;
+        bool sameFileAllowed = true;
+        int minTimeDiffSameFile = 0;
+        int remainingSamplesRequired = 0;
+    };
+
+    // the nearest valid jump for each query, from its currentPoint's own position (or descriptors, when jumping by similarity), the rules are applied during the search so nearer rejected points never hide it
+    // the first maxAllowedTargets entries of the precomputed jump graph are tried before searching, queries that end up searching near each other share walks of the tree
+    // allocates, scratch is the caller's own search state for the descriptor index (prepared here when the index changes), so callers on different threads never share one
+    void FindJumpTargets (  const JumpQuery* queries, size_t count, const Utilities::AudioData& audioSet, size_t hopSize, AudioCache* audioCache,
+                            Utilities::HNSWIndex::Scratch& scratch, Utilities::PointFT* targets, bool* found );
     void FindRandom ( );
 
+    // every corpus point inside a region, selection is sized to the corpus and replaced, returns false (leaving it empty) if nothing is trained
+    // boxes and spheres are in the explorer's space, in 2D only where they cross the plane the points are drawn on counts
+    bool SelectInBox ( const glm::vec3& corner1, const glm::vec3& corner2, Utilities::PointSelection& selection );
+    bool SelectInSphere ( const glm::vec3& centre, float radius, Utilities::PointSelection& selection );
+    // the points within radius of a corpus point, radius in the same 0 - 1 range as the max jump distance, capped at maxPoints (which need not be the nearest)
+    bool SelectNearPoint ( Utilities::PointFT centrePoint, float radius, size_t maxPoints, Utilities::PointSelection& selection );
+    // in pixels through the current camera, main thread only
+    bool SelectInScreenRect ( const glm::vec2& corner1, const glm::vec2& corner2, Utilities::PointSelection& selection );
+    bool SelectInLasso ( const std::vector<glm::vec2>& lasso, Utilities::PointSelection& selection );
+    void GetSelectedPoints ( const Utilities::PointSelection& selection, std::vector<Utilities::PointFT>& points );
+
     // Setters & Getters ----------------------------
 
     void SetCamera ( std::shared_ptr<ofCamera> camera ) { mCamera = camera; }
@@ -61,6 +91,8 @@ public:
     double GetNearestMouseDistance ( ) const { return mNearestDistance; }
     bool IsTrained ( ) const { return bTrained; }
 
+    static constexpr int kMaxJumpTargets = 10; // upper limit for maxAllowedTargets (matches the menu slider), also the jump graph's out degree
+
 private:
     void ScaleDataset ( Utilities::DataSet& scaledDataset, const Utilities::DimensionBounds& dimensionBounds );
 
@@ -97,29 +129,123 @@ private:
 
     int mDimensionsIndices[3];
 
+    bool bJumpAllDimensions;
+    std::vector<int> mJumpDimensions;
+
     int mNearestPoint;
     double mNearestDistance;
 
     double maxAllowedDistanceFar;
     double maxAllowedDistanceNear;
-
-    fluid::algorithm::KDTree mKDTree;
-
-    fluid::FluidDataSet<std::string, double, 1> mFullFluidSet;
-    fluid::FluidDataSet<std::string, double, 1> mLiveFluidSet;
-    std::vector<int> mCorpusFileLookUp; int mNearestPointFile;
-    std::vector<int> mCorpusTimeLookUp; int mNearestPointTime;
-    
-    Utilities::DatasetConversion mDatasetConversion;
-
-    std::vector<glm::vec3> testPoints;
-    std::vector<float> testRadii;
-    std::vector<glm::vec3> testPointsOutOfRange;
-    std::vector<float> testRadiiOutOfRange;
+    double mDesiredRayLength; // in world units, the pick cone widens from near to far over this distance
+
+    int mNearestPointFile;
+    int mNearestPointTime;
+
+    glm::vec3 mDebugRayStart;
+    glm::vec3 mDebugRayEnd;
+
+    // Search index ---------------------------------
+
+    // the corpus scaled to 0-1, stored a column per dimension so a rebuild only reads the columns it uses
+    struct ScaledCorpus {
+        std::vector<std::vector<float>> columns; // [dimension][point]
+        std::vector<int> fileLookUp; // [point]
+        std::vector<int> timeLookUp; // [point]
+        std::vector<uint32_t> fileStarts; // [file], index of the file's first point
+    };
+
+    // everything a search needs, rebuilt by Train and never modified once published
+    struct SearchIndex {
+        Utilities::PointKDTree tree; // payloads are point indices into the corpus lookups
+        bool b3D;
+        bool dimensionsFilled[3];
+        std::shared_ptr<const ScaledCorpus> corpus;
+        int liveDimensions[3];
+        int dimensionCount;
+
+        // only built when jumping by similarity, rows are the chosen dimensions scaled by 1 / sqrt ( count ), so distances stay in the same 0-1 range as the max jump distance
+        Utilities::HNSWIndex descriptors;
+
+        // jump graph in CSR form, point p's kMaxJumpTargets nearest neighbours (itself included) are jumpCandidates[jumpOffsets[p]] up to jumpOffsets[p + 1], nearest first
+        std::vector<uint32_t> jumpOffsets;
+        std::vector<Utilities::PointKDTree::Result> jumpCandidates;
+    };
+
+    struct TrainRequest {
+        std::shared_ptr<const ScaledCorpus> corpus;
+        int liveDimensions[3]; // corpus columns for the filled axes, in x, y, z order
+        bool dimensionsFilled[3];
+        int dimensionCount;
+        std::vector<int> jumpDimensions; // empty for jumps in the displayed space
+    };
+
+    static constexpr size_t kJumpSearchEf = 32; // search width for the descriptor index, the jump graph is built with it too
+    static constexpr size_t kJumpSearchMaxVisits = 2048; // bounds a descriptor search that keeps finding only ruled out targets
+
+    void QueueTrain ( ); // requests a rebuild from the current dimensions, mPointPickerMutex must be held
+    void StartTrainThread ( );
+    void StopTrainThread ( );
+    void TrainThreadLoop ( );
+    static std::unique_ptr<SearchIndex> BuildSearchIndex ( const TrainRequest& request );
+    static glm::vec3 GetIndexPosition ( const SearchIndex& index, uint32_t point ); // position in the index's normalised space
+    static int GetDisplayAxes ( const SearchIndex& index, int axes[3] ); // the explorer axis each index dimension is drawn on, returns how many are used
+
+    struct JumpRules {
+        Utilities::PointFT currentPoint;
+        bool sameFileAllowed;
+        int minTimeDiffSameFile;
+        int remainingSamplesRequired;
+        const Utilities::AudioData* audioSet;
+        size_t hopSize;
+        AudioCache* audioCache;
+    };
+
+    enum class JumpCheck { Valid, Invalid, NotResident };
+
+    static JumpCheck CheckJumpTarget ( const ScaledCorpus& corpus, uint32_t point, const JumpRules& rules );
+    static bool LookUpIndexPoint ( const ScaledCorpus& corpus, Utilities::PointFT point, size_t& indexPoint );
+
+    enum class GraphJump { Found, OutOfRange, Unresolved };
+
+    // tries the first maxAllowedTargets jump graph entries of point, Unresolved if the index still has to be searched
+    static GraphJump TryJumpGraph ( const SearchIndex& index, size_t point, int maxAllowedTargets, float maxDistance, const JumpRules& rules,
+                                    bool& missingFileRequested, Utilities::PointFT& nearestPoint );
+    // searches the descriptor index when descriptorQuery is given, otherwise the tree from position
+    static bool SearchJumpTarget (  const SearchIndex& index, const glm::vec3& position, const float* descriptorQuery, float maxDistance,
+                                    const JumpRules& rules, bool requestMissing, Utilities::HNSWIndex::Scratch& scratch, Utilities::PointFT& nearestPoint );
+    // requests the nearest skipped non resident target if it was nearer than what was found, then writes the target out
+    static bool FinishJumpSearch (  const ScaledCorpus& corpus, bool found, const Utilities::PointKDTree::Result& result,
+                                    const Utilities::PointKDTree::Result& missed, const JumpRules& rules, bool requestMissing,
+                                    Utilities::PointFT& nearestPoint );
+
+    struct PendingJumpSearch {
+        size_t query;
+        uint32_t order; // morton code of position, sorting by it puts queries that search near each other together
+        glm::vec3 position;
+        float maxDistance;
+        JumpRules rules;
+        bool requestMissing;
+    };
+
+    static uint32_t MortonOrder ( const glm::vec3& position );
+    // one batched walk of the tree for up to PointKDTree::kMaxBatch pending searches
+    static void SearchJumpPacket ( const SearchIndex& index, const PendingJumpSearch* packet, size_t count, Utilities::PointFT* targets, bool* found );
+
+    std::shared_ptr<const ScaledCorpus> mCorpus;
+    Utilities::SharedSnapshot<SearchIndex> mSearchIndex; // read without locking by the audio thread
+
+    std::thread mTrainThread;
+    std::mutex mTrainMutex;
+    std::condition_variable mTrainCondition;
+    TrainRequest mTrainRequest; // only the latest request is kept, an older one still waiting is simply replaced
+    uint64_t mTrainGeneration; // bumped by every request and by Clear, a finished build is only published if it is still the latest
+    bool bTrainPending;
+    bool bTrainThreadExit;
 
     // Thread safety --------------------------------
 
-    std::mutex mPointPickerMutex;
+    std::mutex mPointPickerMutex; // UI side state only, searches go through mSearchIndex
 
     // Randomness -----------------------------------
 
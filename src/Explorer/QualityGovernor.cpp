@@ -0,0 +1,125 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Explorer/QualityGovernor.h"
+
+#include <algorithm>
+
+using namespace Acorex;
+
+Explorer::QualityGovernor::QualityGovernor ( ) : bPolicyChanged ( false ), mPublishedLevel ( FULL_QUALITY )
+{
+    Reset ( );
+}
+
+void Explorer::QualityGovernor::SetPolicy ( const Policy& policy )
+{
+    std::lock_guard<std::mutex> lock ( mPolicyMutex );
+    mPendingPolicy = policy;
+    bPolicyChanged = true;
+}
+
+Explorer::QualityGovernor::Policy Explorer::QualityGovernor::GetPolicy ( )
+{
+    std::lock_guard<std::mutex> lock ( mPolicyMutex );
+    return mPendingPolicy;
+}
+
+const char* Explorer::QualityGovernor::GetLevelName ( int level )
+{
+    switch ( level )
+    {
+        case FULL_QUALITY: return "full quality";
+        case SHORT_CROSSFADES: return "short crossfades";
+        case FEWER_JUMPS: return "fewer jumps";
+        case SHED_VOICES: return "shedding voices";
+        default: return "unknown";
+    }
+}
+
+void Explorer::QualityGovernor::Reset ( )
+{
+    {
+        std::lock_guard<std::mutex> lock ( mPolicyMutex );
+        mPolicy = mPendingPolicy;
+        bPolicyChanged = false;
+    }
+
+    mVisualUpdateCounter = 0;
+    Step ( FULL_QUALITY );
+}
+
+size_t Explorer::QualityGovernor::Update ( float loadPercent, double bufferSeconds )
+{
+    if ( bPolicyChanged && mPolicyMutex.try_lock ( ) )
+    {
+        std::lock_guard<std::mutex> lock ( mPolicyMutex, std::adopt_lock );
+        mPolicy = mPendingPolicy;
+        bPolicyChanged = false;
+    }
+
+    if ( !mPolicy.enabled )
+    {
+        if ( mLevel != FULL_QUALITY ) { Step ( FULL_QUALITY ); }
+        return 0;
+    }
+
+    mSinceStepSeconds += bufferSeconds;
+    mUnderSeconds = loadPercent < mPolicy.recoverBelowPercent ? mUnderSeconds + bufferSeconds : 0.0;
+
+    // a single slow callback is enough to step down, but never again until the last step has had time to show in the load
+    bool over = loadPercent >= mPolicy.degradeAbovePercent || loadPercent >= 100.0f;
+    if ( over && mSinceStepSeconds * 1000.0 >= mPolicy.stepIntervalMs )
+    {
+        if ( mLevel < SHED_VOICES ) { Step ( mLevel + 1 ); return 0; }
+
+        mSinceStepSeconds = 0.0;
+        return (size_t)std::max ( mPolicy.shedVoices, 0 );
+    }
+
+    if ( mLevel > FULL_QUALITY && mUnderSeconds * 1000.0 >= mPolicy.recoverAfterMs )
+    {
+        Step ( mLevel - 1 );
+    }
+
+    return 0;
+}
+
+int Explorer::QualityGovernor::CrossfadeSampleLength ( int configured ) const
+{
+    return mLevel >= SHORT_CROSSFADES ? std::min ( configured, mPolicy.crossfadeSampleLength ) : configured;
+}
+
+int Explorer::QualityGovernor::CrossoverJumpChanceX1000 ( int configured ) const
+{
+    return mLevel >= FEWER_JUMPS ? configured * std::clamp ( mPolicy.jumpChancePercent, 0, 100 ) / 100 : configured;
+}
+
+bool Explorer::QualityGovernor::VisualUpdateDue ( )
+{
+    int divisor = mLevel >= SHORT_CROSSFADES ? std::max ( mPolicy.visualUpdateDivisor, 1 ) : 1;
+    mVisualUpdateCounter = ( mVisualUpdateCounter + 1 ) % divisor;
+    return mVisualUpdateCounter == 0;
+}
+
+void Explorer::QualityGovernor::Step ( int level )
+{
+    mLevel = level;
+    mSinceStepSeconds = 0.0;
+    mUnderSeconds = 0.0;
+    mPublishedLevel.store ( level, std::memory_order_relaxed );
+}
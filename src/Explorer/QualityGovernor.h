@@ -0,0 +1,89 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Utilities/TemporaryDefaults.h"
+
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+
+namespace Acorex {
+namespace Explorer {
+
+// lowers playback quality a step at a time while audio callbacks run close to their deadline, and raises it again once they don't
+// fed each callback's load by the audio thread, it only decides how far to degrade, AudioPlayback applies it
+class QualityGovernor {
+public:
+    // each level keeps everything the levels below it do
+    enum Level : int {
+        FULL_QUALITY = 0,
+        SHORT_CROSSFADES = 1, // crossfades capped at crossfadeSampleLength, visual playheads updated every visualUpdateDivisor buffers
+        FEWER_JUMPS = 2, // crossover jump chance scaled down to jumpChancePercent, so fewer crossfades are mixed
+        SHED_VOICES = 3, // the oldest shedVoices playheads faded out at every step still over
+        LEVELS = 4
+    };
+
+    struct Policy {
+        bool enabled = DEFAULT_GOVERNOR_ENABLED;
+        float degradeAbovePercent = DEFAULT_GOVERNOR_DEGRADE_ABOVE_PERCENT; // an overrun always counts as over
+        float recoverBelowPercent = DEFAULT_GOVERNOR_RECOVER_BELOW_PERCENT;
+        int stepIntervalMs = DEFAULT_GOVERNOR_STEP_INTERVAL_MS;
+        int recoverAfterMs = DEFAULT_GOVERNOR_RECOVER_AFTER_MS;
+        int crossfadeSampleLength = DEFAULT_GOVERNOR_CROSSFADE_SAMPLE_LENGTH;
+        int jumpChancePercent = DEFAULT_GOVERNOR_JUMP_CHANCE_PERCENT;
+        int visualUpdateDivisor = DEFAULT_GOVERNOR_VISUAL_UPDATE_DIVISOR;
+        int shedVoices = DEFAULT_GOVERNOR_SHED_VOICES;
+    };
+
+    QualityGovernor ( );
+    ~QualityGovernor ( ) { }
+
+    void SetPolicy ( const Policy& policy ); // any thread, the audio thread picks it up at its next callback
+    Policy GetPolicy ( );
+    int GetLevel ( ) const { return mPublishedLevel.load ( std::memory_order_relaxed ); }
+    static const char* GetLevelName ( int level );
+
+    // audio thread only ------------------------
+
+    void Reset ( ); // back to full quality, audio must not be running
+    size_t Update ( float loadPercent, double bufferSeconds ); // after each callback, returns how many playheads to shed before the next
+
+    int CrossfadeSampleLength ( int configured ) const;
+    int CrossoverJumpChanceX1000 ( int configured ) const;
+    bool VisualUpdateDue ( ); // counts buffers, call once per callback
+
+private:
+    void Step ( int level );
+
+    std::mutex mPolicyMutex; // only ever held briefly by SetPolicy, the audio thread skips the update rather than wait
+    Policy mPendingPolicy;
+    std::atomic<bool> bPolicyChanged;
+
+    std::atomic<int> mPublishedLevel;
+
+    // audio thread only
+    Policy mPolicy;
+    int mLevel;
+    double mSinceStepSeconds; // audio time since the level last changed
+    double mUnderSeconds; // audio time load has been under the recover threshold without a break
+    int mVisualUpdateCounter;
+};
+
+} // namespace Explorer
+} // namespace Acorex
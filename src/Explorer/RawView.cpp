@@ -23,7 +23,8 @@ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 
 using namespace Acorex;
 
-Explorer::RawView::RawView ( ) : mHopSize ( 512 ), mCorpusName ( "" )
+Explorer::RawView::RawView ( ) : mHopSize ( 512 ), mStorageMode ( (Utilities::AudioStorageMode)DEFAULT_AUDIO_STORAGE_MODE ),
+    mCacheBudgetBytes ( (size_t)DEFAULT_AUDIO_CACHE_BUDGET_MB * 1024 * 1024 ), bCompactSamples ( DEFAULT_AUDIO_COMPACT_SAMPLES ), mCorpusName ( "" )
 {
     ClearCorpus ( );
 }
@@ -78,31 +79,71 @@ bool Explorer::RawView::LoadCorpus ( const std::string& path, const std::string&
 
 void Explorer::RawView::ClearCorpus ( )
 {
+    mAudioCache.Stop ( );
     mCorpusName = "";
     mDataset = { };
 }
 
 bool Explorer::RawView::LoadAudioSet ( Utilities::DataSet& dataset )
 {
+    bool compact = bCompactSamples && mStorageMode == Utilities::AudioStorageMode::RESIDENT;
+
+    dataset.audio.storageMode = mStorageMode;
+    dataset.audio.sampleFormat = compact ? Utilities::AudioSampleFormat::INT16 : Utilities::AudioSampleFormat::FLOAT32;
     dataset.audio.loaded.clear ( );
+    dataset.audio.length.clear ( );
     dataset.audio.raw.clear ( );
+    dataset.audio.rawInt16.clear ( );
+
+    std::vector<float> compactDecodeBuffer; // reused between files, compact storage still needs float samples to convert from
 
     for ( int fileIndex = 0; fileIndex < dataset.fileList.size ( ); fileIndex++ )
     {
-        fluid::RealVector fileData;
+        if ( mStorageMode == Utilities::AudioStorageMode::STREAMED || mStorageMode == Utilities::AudioStorageMode::CACHED )
+        {
+            size_t length = 0;
+            bool readable = mAudioLoader.ReadAudioLength ( dataset.fileList[fileIndex], dataset.analysisSettings.sampleRate, length );
+            if ( !readable ) { ofLogError ( "RawView" ) << "Failed to open audio file: " << dataset.fileList[fileIndex]; }
+
+            dataset.audio.loaded.push_back ( readable );
+            dataset.audio.length.push_back ( length );
+            dataset.audio.raw.push_back ( ofSoundBuffer ( ) );
+            dataset.audio.rawInt16.push_back ( { } );
+            continue;
+        }
+
+        ofSoundBuffer audioData; // mono, decoded straight into its sample vector
+        audioData.setSampleRate ( dataset.analysisSettings.sampleRate );
+        std::vector<float>& decodeBuffer = compact ? compactDecodeBuffer : audioData.getBuffer ( );
 
-        if ( !mAudioLoader.ReadAudioFile ( dataset.fileList[fileIndex], fileData, dataset.analysisSettings.sampleRate ) )
+        if ( !mAudioLoader.ReadAudioFile ( dataset.fileList[fileIndex], decodeBuffer, dataset.analysisSettings.sampleRate ) )
         {
             ofLogError ( "RawView" ) << "Failed to load audio file: " << dataset.fileList[fileIndex];
             dataset.audio.loaded.push_back ( false );
+            dataset.audio.length.push_back ( 0 );
             dataset.audio.raw.push_back ( ofSoundBuffer ( ) );
+            dataset.audio.rawInt16.push_back ( { } );
             continue;
         }
 
-        ofSoundBuffer audioData;
-        audioData.copyFrom ( std::vector<float> ( fileData.begin ( ), fileData.end ( ) ), 1, dataset.analysisSettings.sampleRate );
+        if ( compact )
+        {
+            std::vector<int16_t> compactData ( compactDecodeBuffer.size ( ) );
+            for ( size_t i = 0; i < compactData.size ( ); i++ )
+            {
+                compactData[i] = Utilities::FloatToInt16Sample ( compactDecodeBuffer[i] );
+            }
 
-        dataset.audio.raw.push_back ( audioData );
+            dataset.audio.length.push_back ( compactData.size ( ) );
+            dataset.audio.raw.push_back ( ofSoundBuffer ( ) );
+            dataset.audio.rawInt16.push_back ( std::move ( compactData ) );
+            dataset.audio.loaded.push_back ( true );
+            continue;
+        }
+
+        dataset.audio.length.push_back ( audioData.getNumFrames ( ) );
+        dataset.audio.raw.push_back ( std::move ( audioData ) );
+        dataset.audio.rawInt16.push_back ( { } );
         dataset.audio.loaded.push_back ( true );
     }
     
@@ -122,6 +163,11 @@ bool Explorer::RawView::LoadAudioSet ( Utilities::DataSet& dataset )
         return false;
     }
 
+    if ( mStorageMode == Utilities::AudioStorageMode::CACHED )
+    {
+        mAudioCache.Initialise ( dataset, mCacheBudgetBytes );
+    }
+
     return true;
 }
 
@@ -180,4 +226,9 @@ Utilities::DataSet* Explorer::RawView::GetDataset ( )
 size_t Explorer::RawView::GetHopSize ( ) const
 {
     return mHopSize;
+}
+
+Explorer::AudioCache* Explorer::RawView::GetAudioCache ( )
+{
+    return mAudioCache.IsRunning ( ) ? &mAudioCache : nullptr;
 }
\ No newline at end of file
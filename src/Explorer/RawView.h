@@ -19,6 +19,7 @@ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 #include "Utilities/Data.h"
 #include "Utilities/JSON.h"
 #include "Utilities/AudioFileLoader.h"
+#include "Explorer/AudioCache.h"
 
 namespace Acorex {
 namespace Explorer {
@@ -43,17 +44,22 @@ public:
     Utilities::TrailData* GetTrailData ( ); // get trail data from dataset
     Utilities::DataSet* GetDataset ( ); // get dataset
     size_t GetHopSize ( ) const; // get hop size used in analysis
+    AudioCache* GetAudioCache ( ); // get on demand audio cache, nullptr unless the corpus is loaded in cached storage mode
 
 private:
-    bool LoadAudioSet ( Utilities::DataSet& dataset ); // load all audio files in dataset into memory
+    bool LoadAudioSet ( Utilities::DataSet& dataset ); // load all audio files in dataset into memory, or only their lengths if streamed or cached
 
     size_t mHopSize;
+    Utilities::AudioStorageMode mStorageMode; // compile time only for now, see DEFAULT_AUDIO_STORAGE_MODE
+    size_t mCacheBudgetBytes; // DEFAULT_AUDIO_CACHE_BUDGET_MB
+    bool bCompactSamples; // DEFAULT_AUDIO_COMPACT_SAMPLES, resident storage only
 
     std::string mCorpusName;
     Utilities::DataSet mDataset;
 
     Utilities::JSON mJSON;
     Utilities::AudioFileLoader mAudioLoader;
+    AudioCache mAudioCache;
 };
 
 } // namespace Explorer
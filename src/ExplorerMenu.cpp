@@ -45,6 +45,7 @@ ExplorerMenu::ExplorerMenu ( ) :    mSlowUpdateInterval ( 100 ), mOpenCorpusButt
     mDisabledAxis = Utilities::Axis::NONE;
 
     mLastUpdateTime = 0;
+    mLastTelemetrySendTime = 0;
     mOpenCorpusButtonClickTime = 0;
 }
 
@@ -223,13 +224,84 @@ void ExplorerMenu::UpdateOscReceiver ( )
                     mLiveView.KillPlayhead ( playheadID );
                 }
             }
+            else if ( messageAddress == "/governor" && message.getNumArgs ( ) > 0 && message.getArgType ( 0 ) == OFXOSC_TYPE_INT32 )
+            {
+                ofLogVerbose ( "OSC-CONTROL-RECEIVER" ) << "Received quality governor message for receiver index " << mControlReceiverIndex << ".";
+                Explorer::QualityGovernor::Policy policy = mLiveView.GetAudioPlayback ( )->GetGovernorPolicy ( );
+                policy.enabled = message.getArgAsInt ( 0 ) != 0;
+                mLiveView.GetAudioPlayback ( )->SetGovernorPolicy ( policy );
+            }
+            else if ( messageAddress == "/governor_thresholds" && message.getNumArgs ( ) > 1 && message.getArgType ( 0 ) == OFXOSC_TYPE_INT32 && message.getArgType ( 1 ) == OFXOSC_TYPE_INT32 )
+            {
+                ofLogVerbose ( "OSC-CONTROL-RECEIVER" ) << "Received quality governor thresholds message for receiver index " << mControlReceiverIndex << ".";
+                Explorer::QualityGovernor::Policy policy = mLiveView.GetAudioPlayback ( )->GetGovernorPolicy ( );
+                policy.degradeAbovePercent = (float)message.getArgAsInt ( 0 );
+                policy.recoverBelowPercent = (float)message.getArgAsInt ( 1 );
+                mLiveView.GetAudioPlayback ( )->SetGovernorPolicy ( policy );
+            }
         }
     }
 }
 
+void ExplorerMenu::SendOscTelemetry ( )
+{
+    Explorer::AudioPlayback::Telemetry telemetry = mLiveView.GetAudioPlayback ( )->GetTelemetry ( );
+
+    // counts are totals since the audio stream last started, a listener diffs them between bundles for rates
+    ofxOscBundle bundle;
+    auto addCount = [&bundle] ( const std::string& address, uint64_t count )
+    {
+        ofxOscMessage message;
+        message.setAddress ( "/acorex/telemetry" + address );
+        message.addInt64Arg ( (int64_t)count );
+        bundle.addMessage ( message );
+    };
+
+    {
+        ofxOscMessage message;
+        message.setAddress ( "/acorex/telemetry/load" );
+        message.addFloatArg ( telemetry.loadPercent );
+        message.addFloatArg ( telemetry.peakLoadPercent );
+        bundle.addMessage ( message );
+    }
+    {
+        ofxOscMessage message;
+        message.setAddress ( "/acorex/telemetry/load_histogram" );
+        for ( int i = 0; i < Explorer::AudioPlayback::kLoadHistogramBuckets; i++ ) { message.addInt64Arg ( (int64_t)telemetry.loadHistogram[i] ); }
+        bundle.addMessage ( message );
+    }
+
+    addCount ( "/callbacks", telemetry.callbacks );
+    addCount ( "/overruns", telemetry.overruns );
+    addCount ( "/late_callbacks", telemetry.lateCallbacks );
+    addCount ( "/jumps_taken", telemetry.jumpsTaken );
+    for ( int i = 0; i < Explorer::AudioPlayback::JUMP_SKIP_CAUSES; i++ )
+    {
+        addCount ( std::string ( "/jumps_skipped/" ) + Explorer::AudioPlayback::GetJumpSkipCauseName ( i ), telemetry.jumpsSkipped[i] );
+    }
+    addCount ( "/voices_ended", telemetry.voicesEnded );
+    addCount ( "/voices_killed", telemetry.voicesKilled );
+    addCount ( "/voices_shed", telemetry.voicesShed );
+    addCount ( "/creates_refused", telemetry.createsRefused );
+    addCount ( "/commands_dropped", telemetry.commandsDropped );
+
+    {
+        ofxOscMessage message;
+        message.setAddress ( "/acorex/telemetry/quality_level" );
+        message.addIntArg ( telemetry.qualityLevel );
+        bundle.addMessage ( message );
+    }
+
+    mTelemetrySender.sendBundle ( bundle );
+}
+
 void ExplorerMenu::SlowUpdate ( )
 {
-    mLiveView.SlowUpdate ( );
+    if ( bIsCorpusOpen && ofGetElapsedTimeMillis ( ) - mLastTelemetrySendTime > DEFAULT_TELEMETRY_OSC_INTERVAL_MS )
+    {
+        mLastTelemetrySendTime = ofGetElapsedTimeMillis ( );
+        SendOscTelemetry ( );
+    }
 
     if ( bDrawOpenCorpusWarning && ofGetElapsedTimeMillis ( ) - mOpenCorpusButtonClickTime > mOpenCorpusButtonTimeout )
     {
@@ -397,6 +469,10 @@ void ExplorerMenu::SetupPanelSectionCorpusControls ( const Utilities::ExploreSet
     // Jump Max Targets Slider
     mMainPanel.add ( mMaxJumpTargetsSlider.setup ( "Max Jump Targets", settings.GetMaxJumpTargets ( ), 1, 10 ) );
     mMaxJumpTargetsSlider.setBackgroundColor ( mColors.interfaceBackgroundColor );
+
+    // Jump By All Dimensions Toggle
+    mMainPanel.add ( mJumpAllDimensionsToggle.setup ( "Jump by similarity in all dimensions", settings.GetJumpAllDimensions ( ) ) );
+    mJumpAllDimensionsToggle.setBackgroundColor ( mColors.interfaceBackgroundColor );
     
     // 
     
@@ -530,6 +606,7 @@ void ExplorerMenu::RefreshFullPanelUI ( )
     mCrossfadeSampleLengthSlider.setSize ( mLayout->getExplorePanelWidth ( ), mLayout->getPanelRowHeight ( ) );
     mMaxJumpDistanceSpaceSlider.setSize ( mLayout->getExplorePanelWidth ( ), mLayout->getPanelRowHeight ( ) );
     mMaxJumpTargetsSlider.setSize ( mLayout->getExplorePanelWidth ( ), mLayout->getPanelRowHeight ( ) );
+    mJumpAllDimensionsToggle.setSize ( mLayout->getExplorePanelWidth ( ), mLayout->getPanelRowHeight ( ) );
     
     mVolumeSliderX1000.setSize ( mLayout->getExplorePanelWidth ( ), mLayout->getPanelRowHeight ( ) );
     mDimensionDropdownDynamicPan->setSize ( mLayout->getExplorePanelWidth ( ), mLayout->getPanelDropdownRowHeight ( ) );
@@ -591,6 +668,7 @@ void ExplorerMenu::AddListenersCorpusControls ( )
     mCrossfadeSampleLengthSlider.addListener ( this, &ExplorerMenu::SetCrossfadeSampleLengthListener );
     mMaxJumpDistanceSpaceSlider.addListener ( this, &ExplorerMenu::SetMaxJumpDistanceSpaceListener );
     mMaxJumpTargetsSlider.addListener ( this, &ExplorerMenu::SetMaxJumpTargetsListener );
+    mJumpAllDimensionsToggle.addListener ( this, &ExplorerMenu::ToggleJumpAllDimensionsListener );
 
     mVolumeSliderX1000.addListener ( this, &ExplorerMenu::SetVolumeX1000Listener );
 
@@ -622,6 +700,7 @@ void ExplorerMenu::RemoveListenersCorpusControls ( )
     mCrossfadeSampleLengthSlider.removeListener ( this, &ExplorerMenu::SetCrossfadeSampleLengthListener );
     mMaxJumpDistanceSpaceSlider.removeListener ( this, &ExplorerMenu::SetMaxJumpDistanceSpaceListener );
     mMaxJumpTargetsSlider.removeListener ( this, &ExplorerMenu::SetMaxJumpTargetsListener );
+    mJumpAllDimensionsToggle.removeListener ( this, &ExplorerMenu::ToggleJumpAllDimensionsListener );
 
     mVolumeSliderX1000.removeListener ( this, &ExplorerMenu::SetVolumeX1000Listener );
 
@@ -730,6 +809,7 @@ void ExplorerMenu::OpenCorpus ( )
         initialSettings.SetCrossfadeSampleLength ( DEFAULT_CROSSFADE_SAMPLE_LENGTH );
         initialSettings.SetMaxJumpDistanceSpaceX1000 ( DEFAULT_MAX_JUMP_DISTANCE_SPACE_X1000 );
         initialSettings.SetMaxJumpTargets ( DEFAULT_MAX_JUMP_TARGETS );
+        initialSettings.SetJumpAllDimensions ( DEFAULT_JUMP_ALL_DIMENSIONS );
 
         initialSettings.SetVolumeX1000 ( DEFAULT_VOLUME_X1000 );
         initialSettings.SetDimensionDynamicPan ( DEFAULT_DIMENSION_DYNAMIC_PAN );
@@ -769,6 +849,7 @@ void ExplorerMenu::OpenCorpus ( )
     CameraSwitcher ( );
 
     mControlReceiver.setup ( "localhost", ACOREX_OSC_PORT + mControlReceiverIndex );
+    mTelemetrySender.setup ( "localhost", DEFAULT_TELEMETRY_OSC_PORT + mControlReceiverIndex );
 
     bIsCorpusOpen = true;
 
@@ -883,6 +964,7 @@ void ExplorerMenu::PropogateCorpusSettings ( const Utilities::ExploreSettings& s
     SetCrossfadeSampleLength ( settings.GetCrossfadeSampleLengthLimitedByHopSize ( ) );
     SetMaxJumpDistanceSpace ( settings.GetMaxJumpDistanceSpace ( ) );
     SetMaxJumpTargets ( settings.GetMaxJumpTargets ( ) );
+    ToggleJumpAllDimensions ( settings.GetJumpAllDimensions ( ) );
 
     SetVolumeX1000 ( settings.GetVolumeX1000 ( ) );
     SetDimensionDynamicPan ( settings.GetDimensionDynamicPan ( ) );
@@ -895,6 +977,7 @@ void ExplorerMenu::SetControlReceiverIndex ( const int& index )
 {
     mControlReceiverIndex = index;
     mControlReceiver.setup ( "localhost", ACOREX_OSC_PORT + mControlReceiverIndex );
+    mTelemetrySender.setup ( "localhost", DEFAULT_TELEMETRY_OSC_PORT + mControlReceiverIndex );
 }
 
 void ExplorerMenu::SetDimensionX ( const string& dimension )
@@ -960,6 +1043,11 @@ void ExplorerMenu::SetMaxJumpTargets ( const int& targets )
     mLiveView.GetAudioPlayback ( )->SetMaxJumpTargets ( targets );
 }
 
+void ExplorerMenu::ToggleJumpAllDimensions ( const bool& all )
+{
+    mLiveView.GetPointPicker ( )->SetJumpAllDimensions ( all );
+}
+
 void ExplorerMenu::SetVolumeX1000 ( const int& volumeX1000 )
 {
     mLiveView.GetAudioPlayback ( )->SetVolumeX1000 ( volumeX1000 );
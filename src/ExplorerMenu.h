@@ -54,6 +54,7 @@ public:
 
 private:
     void UpdateOscReceiver ( );
+    void SendOscTelemetry ( ); // audio thread telemetry, to DEFAULT_TELEMETRY_OSC_PORT + the control receiver index
     void SlowUpdate ( );
 
     // UI Management -------------------------------
@@ -100,6 +101,8 @@ private:
 
     int mControlReceiverIndex;
     ofxOscReceiver mControlReceiver;
+    ofxOscSender mTelemetrySender;
+    uint64_t mLastTelemetrySendTime;
     // ADD A NEW UI ELEMENT TO SWITCH RECEIVER INDEX
 
     // Listener Functions --------------------------
@@ -120,6 +123,7 @@ private:
     void SetCrossfadeSampleLength ( const int& length );        void SetCrossfadeSampleLengthListener ( int& length ) { SetCrossfadeSampleLength ( length ); }
     void SetMaxJumpDistanceSpace ( const float& distance );     void SetMaxJumpDistanceSpaceListener ( float& distance ) { SetMaxJumpDistanceSpace ( distance ); }
     void SetMaxJumpTargets ( const int& targets );              void SetMaxJumpTargetsListener ( int& targets ) { SetMaxJumpTargets ( targets ); }
+    void ToggleJumpAllDimensions ( const bool& all );           void ToggleJumpAllDimensionsListener ( bool& all ) { ToggleJumpAllDimensions ( all ); }
 
     void SetVolumeX1000 ( const int& volumeX1000 );             void SetVolumeX1000Listener ( int& volumeX1000 ) { SetVolumeX1000 ( volumeX1000 ); }
     void SetDimensionDynamicPan ( const string& dimension );    void SetDimensionDynamicPanListener ( string& dimension ) { SetDimensionDynamicPan ( dimension ); }
@@ -180,6 +184,7 @@ private:
     ofxIntSlider mCrossfadeSampleLengthSlider;
     ofxFloatSlider mMaxJumpDistanceSpaceSlider;
     ofxIntSlider mMaxJumpTargetsSlider;
+    ofxToggle mJumpAllDimensionsToggle;
 
     ofxPercentSlider mVolumeSliderX1000;
     unique_ptr<ofxDropdown> mDimensionDropdownDynamicPan;
@@ -15,87 +15,127 @@ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 */
 
 #include "Utilities/AudioFileLoader.h"
+#include "Utilities/Resampler.h"
 
-#include <ofSoundBuffer.h>
+#include <ofFileUtils.h>
 #include "ofLog.h"
+#include <algorithm>
+#include <type_traits>
 
 using namespace Acorex;
 
 bool Utilities::AudioFileLoader::ReadAudioFile ( std::string filename, fluid::RealVector& output, double targetSampleRate )
 {
-    if ( !ofFile::doesFileExist ( filename ) )
-    {
-        ofLogError ( "AudioFileLoader" ) << "input file " << filename << " does not exist";
-        return false;
-    }
+    AudioFileStream file;
+    if ( !OpenFile ( filename, file ) ) { return false; }
 
-    if ( filename.find ( ".mp3" ) != std::string::npos || filename.find ( ".ogg" ) != std::string::npos ||
-        filename.find ( ".wav" ) != std::string::npos || filename.find ( ".flac" ) != std::string::npos )
-    {
-        ofxAudioFile file;
-        file.load ( filename );
+    output.resize ( GetResampledLength ( file, targetSampleRate ) );
+    return DecodeToMono ( file, output.data ( ), output.size ( ), targetSampleRate );
+}
 
-        if ( !file.loaded ( ) )
-        {
-            ofLogError ( "AudioFileLoader" ) << "input file " << filename << " could not be opened";
-            return false;
-        }
+bool Utilities::AudioFileLoader::ReadAudioFile ( std::string filename, std::vector<float>& output, double targetSampleRate )
+{
+    AudioFileStream file;
+    if ( !OpenFile ( filename, file ) ) { return false; }
 
-        std::vector<float> temp;
+    output.resize ( GetResampledLength ( file, targetSampleRate ) );
+    return DecodeToMono ( file, output.data ( ), output.size ( ), targetSampleRate );
+}
+
+bool Utilities::AudioFileLoader::ReadAudioFile ( std::string filename, float* output, size_t outputFrames, double targetSampleRate )
+{
+    AudioFileStream file;
+    if ( !OpenFile ( filename, file ) ) { return false; }
+
+    return DecodeToMono ( file, output, outputFrames, targetSampleRate );
+}
 
-        ReadToMono ( temp, file );
+bool Utilities::AudioFileLoader::ReadAudioLength ( std::string filename, double targetSampleRate, size_t& length )
+{
+    AudioFileStream file;
+    if ( !OpenFile ( filename, file ) ) { return false; }
 
-        Resample ( temp, file.samplerate ( ), targetSampleRate );
+    length = GetResampledLength ( file, targetSampleRate );
+    return length > 0;
+}
 
-        output.resize ( temp.size ( ) );
-        std::copy ( temp.begin ( ), temp.end ( ), output.data ( ) );
+bool Utilities::AudioFileLoader::OpenFile ( const std::string& filename, AudioFileStream& file )
+{
+    if ( !ofFile::doesFileExist ( filename ) )
+    {
+        ofLogError ( "AudioFileLoader" ) << "input file " << filename << " does not exist";
+        return false;
     }
-    else
+
+    if ( !file.Open ( filename ) )
     {
-        ofLogError ( "AudioFileLoader" ) << "input file " << filename << " is not valid. Supported file types: mp3, ogg, wav, flac";
+        ofLogError ( "AudioFileLoader" ) << "input file " << filename << " could not be opened";
         return false;
     }
 
     return true;
 }
 
-void Utilities::AudioFileLoader::ReadToMono ( std::vector<float>& output, ofxAudioFile& file )
+size_t Utilities::AudioFileLoader::GetResampledLength ( const AudioFileStream& file, double targetSampleRate )
+{
+    if ( file.GetSampleRate ( ) == targetSampleRate ) { return (size_t)file.GetLength ( ); }
+
+    return (size_t)( (double)file.GetLength ( ) * targetSampleRate / file.GetSampleRate ( ) );
+}
+
+template <typename SampleType>
+bool Utilities::AudioFileLoader::DecodeToMono ( AudioFileStream& file, SampleType* output, size_t outputFrames, double targetSampleRate )
 {
-    int numChannels = file.channels ( );
-    int numSamples = file.length ( );
-    output.resize ( numSamples );
+    const size_t chunkFrames = 16384;
+
+    Resampler resampler;
+    resampler.Initialise ( file.GetSampleRate ( ), targetSampleRate );
+
+    // float output at the file's own rate needs no intermediate buffers at all
+    bool direct = resampler.IsPassthrough ( ) && std::is_same<SampleType, float>::value;
+
+    std::vector<float> monoChunk;
+    std::vector<float> resampleChunk;
+    if ( !direct ) { monoChunk.resize ( chunkFrames ); }
+    if ( !resampler.IsPassthrough ( ) )
+    {
+        resampleChunk.resize ( resampler.GetMaxOutputFrames ( chunkFrames ) + resampler.GetMaxOutputFrames ( resampler.GetLatency ( ) ) );
+    }
 
-    if ( numChannels == 1 )
+    size_t written = 0;
+    bool endOfFile = false;
+    while ( written < outputFrames && !endOfFile )
     {
-        for ( int sample = 0; sample < numSamples; sample++ )
+        if constexpr ( std::is_same<SampleType, float>::value )
         {
-            output[sample] = file.sample ( sample, 0 );
+            if ( direct )
+            {
+                size_t request = std::min ( chunkFrames, outputFrames - written );
+                size_t framesRead = file.ReadMono ( output + written, request );
+                written += framesRead;
+                endOfFile = framesRead < request;
+                continue;
+            }
         }
-        return;
-    }
 
-    std::fill ( output.begin ( ), output.end ( ), 0 );
+        size_t framesRead = file.ReadMono ( monoChunk.data ( ), chunkFrames );
+        endOfFile = framesRead < chunkFrames;
 
-#pragma omp parallel for
-    for ( int sample = 0; sample < numSamples; sample++ )
-    {
-        for ( int channel = 0; channel < numChannels; channel++ )
+        const float* chunk = monoChunk.data ( );
+        size_t produced = framesRead;
+        if ( !resampler.IsPassthrough ( ) )
         {
-            output[sample] += file.sample ( sample, channel );
+            produced = resampler.ProcessChunk ( monoChunk.data ( ), framesRead, resampleChunk.data ( ) );
+            if ( endOfFile ) { produced += resampler.Flush ( resampleChunk.data ( ) + produced ); }
+            chunk = resampleChunk.data ( );
         }
-        output[sample] /= numChannels;
-    }
-}
 
-void Utilities::AudioFileLoader::Resample ( std::vector<float>& audio, double fileRate, double targetRate  )
-{
-    ofSoundBuffer resampleBuffer;
+        produced = std::min ( produced, outputFrames - written );
+        std::copy ( chunk, chunk + produced, output + written );
+        written += produced;
+    }
 
-    resampleBuffer.copyFrom ( audio, 1, fileRate );
-    
-    resampleBuffer.resample ( (fileRate / targetRate), ofSoundBuffer::Hermite );
-    resampleBuffer.setSampleRate ( targetRate );
+    std::fill ( output + written, output + outputFrames, (SampleType)0 );
 
-    audio.resize ( resampleBuffer.size ( ) );
-    resampleBuffer.copyTo ( audio.data ( ), resampleBuffer.size ( ), 1, 0, false );
-}
\ No newline at end of file
+    return true;
+}
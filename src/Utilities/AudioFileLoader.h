@@ -16,24 +16,36 @@ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 
 #pragma once
 
+#include "Utilities/AudioFileStream.h"
+
 #include <flucoma/data/TensorTypes.hpp>
-#include <ofxAudioFile.h>
 #include <string>
+#include <vector>
 
 namespace Acorex {
 namespace Utilities {
 
+// decodes whole files to mono at a target sample rate
+// files are decoded, downmixed and resampled a chunk at a time straight into the output, without holding the multichannel file in memory
+// holds no state between calls, so one loader can be shared between threads
 class AudioFileLoader {
 public:
     AudioFileLoader ( ) { }
     ~AudioFileLoader ( ) { }
 
     bool ReadAudioFile ( std::string filename, fluid::RealVector& output, double targetSampleRate );
+    bool ReadAudioFile ( std::string filename, std::vector<float>& output, double targetSampleRate ); // resized to the file length
+    bool ReadAudioFile ( std::string filename, float* output, size_t outputFrames, double targetSampleRate ); // pre-allocated, zero padded past the end of the file
+
+    bool ReadAudioLength ( std::string filename, double targetSampleRate, size_t& length ); // length in samples after resampling, without decoding
 
 private:
-    void ReadToMono ( std::vector<float>& output, ofxAudioFile& file );
+    bool OpenFile ( const std::string& filename, AudioFileStream& file );
+    size_t GetResampledLength ( const AudioFileStream& file, double targetSampleRate );
 
-    void Resample ( std::vector<float>& audio, double fileRate, double targetRate );
+    // SampleType is float, or double for analysis buffers
+    template <typename SampleType>
+    bool DecodeToMono ( AudioFileStream& file, SampleType* output, size_t outputFrames, double targetSampleRate );
 };
 
 } // namespace Utilities
@@ -0,0 +1,220 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Utilities/AudioFileStream.h"
+
+#include <dr_wav.h>
+#include <dr_flac.h>
+#include <dr_mp3.h>
+#define STB_VORBIS_HEADER_ONLY
+#include <stb_vorbis.h>
+#include "ofLog.h"
+#include <algorithm>
+#include <cctype>
+
+using namespace Acorex;
+
+// decoder implementations are compiled in with ofxAudioFile, only the declarations are needed here
+
+Utilities::AudioFileStream::AudioFileStream ( )
+    : mFormat ( Format::NONE ), mDecoder ( nullptr ), mFilename ( "" ), mChannels ( 0 ), mSampleRate ( 0.0 ), mLength ( 0 )
+{
+}
+
+bool Utilities::AudioFileStream::Open ( const std::string& filename )
+{
+    Close ( );
+
+    // the format comes from the extension, in any case, as ofxAudioFile decides it
+    size_t dot = filename.find_last_of ( '.' );
+    std::string extension = dot == std::string::npos ? "" : filename.substr ( dot + 1 );
+    std::transform ( extension.begin ( ), extension.end ( ), extension.begin ( ), [] ( unsigned char c ) { return (char)std::tolower ( c ); } );
+
+    if ( extension == "wav" )
+    {
+        drwav* wav = new drwav;
+        if ( !drwav_init_file ( wav, filename.c_str ( ), NULL ) ) { delete wav; }
+        else
+        {
+            mFormat = Format::WAV; mDecoder = wav;
+            mChannels = wav->channels; mSampleRate = wav->sampleRate; mLength = wav->totalPCMFrameCount;
+        }
+    }
+    else if ( extension == "flac" )
+    {
+        drflac* flac = drflac_open_file ( filename.c_str ( ), NULL );
+        if ( flac != NULL )
+        {
+            mFormat = Format::FLAC; mDecoder = flac;
+            mChannels = flac->channels; mSampleRate = flac->sampleRate; mLength = flac->totalPCMFrameCount;
+        }
+    }
+    else if ( extension == "mp3" )
+    {
+        drmp3* mp3 = new drmp3;
+        if ( !drmp3_init_file ( mp3, filename.c_str ( ), NULL ) ) { delete mp3; }
+        else
+        {
+            mFormat = Format::MP3; mDecoder = mp3;
+            mChannels = mp3->channels; mSampleRate = mp3->sampleRate;
+            mLength = drmp3_get_pcm_frame_count ( mp3 ); // scans the whole file, but leaves the decoder at the start again
+        }
+    }
+    else if ( extension == "ogg" )
+    {
+        int error = 0;
+        stb_vorbis* ogg = stb_vorbis_open_filename ( filename.c_str ( ), &error, NULL );
+        if ( ogg != NULL )
+        {
+            stb_vorbis_info info = stb_vorbis_get_info ( ogg );
+            mFormat = Format::OGG; mDecoder = ogg;
+            mChannels = info.channels; mSampleRate = info.sample_rate; mLength = stb_vorbis_stream_length_in_samples ( ogg );
+        }
+    }
+    else
+    {
+        ofLogError ( "AudioFileStream" ) << "input file " << filename << " is not valid. Supported file types: mp3, ogg, wav, flac";
+        return false;
+    }
+
+    if ( mFormat == Format::NONE )
+    {
+        ofLogError ( "AudioFileStream" ) << "input file " << filename << " could not be opened";
+        return false;
+    }
+
+    if ( mChannels == 0 || mSampleRate <= 0.0 )
+    {
+        ofLogError ( "AudioFileStream" ) << "input file " << filename << " has an invalid format";
+        Close ( );
+        return false;
+    }
+
+    mFilename = filename;
+    return true;
+}
+
+void Utilities::AudioFileStream::Close ( )
+{
+    switch ( mFormat )
+    {
+    case Format::WAV:   drwav_uninit ( (drwav*)mDecoder ); delete (drwav*)mDecoder; break;
+    case Format::FLAC:  drflac_close ( (drflac*)mDecoder ); break;
+    case Format::MP3:   drmp3_uninit ( (drmp3*)mDecoder ); delete (drmp3*)mDecoder; break;
+    case Format::OGG:   stb_vorbis_close ( (stb_vorbis*)mDecoder ); break;
+    default: break;
+    }
+
+    mFormat = Format::NONE;
+    mDecoder = nullptr;
+    mFilename = "";
+    mChannels = 0;
+    mSampleRate = 0.0;
+    mLength = 0;
+    std::vector<float> ( ).swap ( mInterleavedBuffer );
+}
+
+bool Utilities::AudioFileStream::Seek ( uint64_t frame )
+{
+    if ( frame > mLength ) { frame = mLength; }
+
+    switch ( mFormat )
+    {
+    case Format::WAV:   return drwav_seek_to_pcm_frame ( (drwav*)mDecoder, frame );
+    case Format::FLAC:  return drflac_seek_to_pcm_frame ( (drflac*)mDecoder, frame );
+    case Format::MP3:   return drmp3_seek_to_pcm_frame ( (drmp3*)mDecoder, frame );
+    case Format::OGG:   return stb_vorbis_seek ( (stb_vorbis*)mDecoder, (unsigned int)frame ) != 0;
+    default:            return false;
+    }
+}
+
+size_t Utilities::AudioFileStream::Read ( float* interleavedOutput, size_t frames )
+{
+    switch ( mFormat )
+    {
+    case Format::WAV:   return (size_t)drwav_read_pcm_frames_f32 ( (drwav*)mDecoder, frames, interleavedOutput );
+    case Format::FLAC:  return (size_t)drflac_read_pcm_frames_f32 ( (drflac*)mDecoder, frames, interleavedOutput );
+    case Format::MP3:   return (size_t)drmp3_read_pcm_frames_f32 ( (drmp3*)mDecoder, frames, interleavedOutput );
+    case Format::OGG:   return (size_t)stb_vorbis_get_samples_float_interleaved ( (stb_vorbis*)mDecoder, (int)mChannels, interleavedOutput, (int)(frames * mChannels) );
+    default:            return 0;
+    }
+}
+
+size_t Utilities::AudioFileStream::ReadMono ( float* output, size_t frames )
+{
+    if ( mChannels == 1 ) { return Read ( output, frames ); }
+
+    const size_t blockFrames = 4096;
+    mInterleavedBuffer.resize ( blockFrames * mChannels );
+
+    size_t framesRead = 0;
+    while ( framesRead < frames )
+    {
+        size_t request = std::min ( blockFrames, frames - framesRead );
+        size_t decoded = Read ( mInterleavedBuffer.data ( ), request );
+        DownmixToMono ( mInterleavedBuffer.data ( ), decoded, mChannels, output + framesRead );
+        framesRead += decoded;
+
+        if ( decoded < request ) { break; }
+    }
+
+    return framesRead;
+}
+
+void Utilities::AudioFileStream::DownmixToMono ( const float* interleaved, size_t frames, size_t channels, float* output )
+{
+    if ( channels == 1 )
+    {
+        std::copy ( interleaved, interleaved + frames, output );
+        return;
+    }
+
+    float channelGain = 1.0f / (float)channels;
+
+    if ( channels == 2 )
+    {
+#pragma omp simd
+        for ( size_t frame = 0; frame < frames; frame++ )
+        {
+            output[frame] = (interleaved[frame * 2] + interleaved[frame * 2 + 1]) * channelGain;
+        }
+        return;
+    }
+
+    // one strided pass per channel keeps each loop simple enough to vectorise
+#pragma omp simd
+    for ( size_t frame = 0; frame < frames; frame++ )
+    {
+        output[frame] = interleaved[frame * channels];
+    }
+
+    for ( size_t channel = 1; channel < channels; channel++ )
+    {
+        const float* input = interleaved + channel;
+#pragma omp simd
+        for ( size_t frame = 0; frame < frames; frame++ )
+        {
+            output[frame] += input[frame * channels];
+        }
+    }
+
+#pragma omp simd
+    for ( size_t frame = 0; frame < frames; frame++ )
+    {
+        output[frame] *= channelGain;
+    }
+}
@@ -0,0 +1,74 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Acorex {
+namespace Utilities {
+
+// seekable, chunked decoder for a single audio file, used where decoding the whole file up front is not wanted
+// reads interleaved float frames at the file's native rate and channel count, or mono frames downmixed as they are decoded
+class AudioFileStream {
+public:
+    AudioFileStream ( );
+    ~AudioFileStream ( ) { Close ( ); }
+
+    AudioFileStream ( const AudioFileStream& ) = delete;
+    AudioFileStream& operator= ( const AudioFileStream& ) = delete;
+
+    bool Open ( const std::string& filename );
+    void Close ( );
+
+    bool Seek ( uint64_t frame );
+    size_t Read ( float* interleavedOutput, size_t frames ); // returns frames read, less than requested only at end of file
+    size_t ReadMono ( float* output, size_t frames ); // as Read, with all channels averaged
+
+    static void DownmixToMono ( const float* interleaved, size_t frames, size_t channels, float* output );
+
+    bool IsOpen ( ) const { return mFormat != Format::NONE; }
+    const std::string& GetFilename ( ) const { return mFilename; }
+    size_t GetChannels ( ) const { return mChannels; }
+    double GetSampleRate ( ) const { return mSampleRate; }
+    uint64_t GetLength ( ) const { return mLength; } // in frames
+
+private:
+    enum class Format : int {
+        NONE = 0,
+        WAV = 1,
+        FLAC = 2,
+        MP3 = 3,
+        OGG = 4
+    };
+
+    Format mFormat;
+    void* mDecoder;
+
+    std::string mFilename;
+    size_t mChannels;
+    double mSampleRate;
+    uint64_t mLength;
+
+    std::vector<float> mInterleavedBuffer; // ReadMono only, decodes a block of multichannel frames at a time
+};
+
+} // namespace Utilities
+} // namespace Acorex
@@ -21,12 +21,15 @@ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 #include <ofSoundBuffer.h>
 #include <string>
 #include <vector>
-#include <queue>
+#include <deque>
+#include <random>
 #include <nlohmann/json.hpp>
 #include <ofColor.h>
 #include <ofRectangle.h>
 #include <algorithm>
 #include <ofMath.h>
+#include <cstdint>
+#include <cmath>
 #include <ofGraphics.h>
 #include <of3dGraphics.h>
 
@@ -50,9 +53,27 @@ struct DimensionBoundsData {
     std::vector<double> max; // [dimension]
 };
 
+enum class AudioStorageMode : int {
+    RESIDENT = 0, // every file decoded into raw when the corpus is opened
+    STREAMED = 1, // raw is left empty, files are decoded from disk during playback
+    CACHED = 2 // raw is left empty, files are decoded on demand into the RawView audio cache
+};
+
+enum class AudioSampleFormat : int {
+    FLOAT32 = 0, // resident audio in raw
+    INT16 = 1 // resident audio in rawInt16, raw is left empty
+};
+
+inline int16_t FloatToInt16Sample ( float sample ) { return (int16_t)std::lrint ( std::clamp ( sample, -1.0f, 1.0f ) * 32767.0f ); }
+inline float Int16ToFloatSample ( int16_t sample ) { return (float)sample * (1.0f / 32767.0f); }
+
 struct AudioData {
+    AudioStorageMode storageMode = AudioStorageMode::RESIDENT;
+    AudioSampleFormat sampleFormat = AudioSampleFormat::FLOAT32;
     std::vector<bool> loaded; // [file]
+    std::vector<size_t> length; // [file] (in samples at the analysis sample rate, valid in every storage mode)
     std::vector<ofSoundBuffer> raw; // [file]
+    std::vector<std::vector<int16_t>> rawInt16; // [file]
 };
 
 struct TrailData {
@@ -77,6 +98,7 @@ private:
     int crossfadeSampleLength = DEFAULT_CROSSFADE_SAMPLE_LENGTH;
     int maxJumpDistanceSpaceX1000 = DEFAULT_MAX_JUMP_DISTANCE_SPACE_X1000;
     int maxJumpTargets = DEFAULT_MAX_JUMP_TARGETS;
+    bool jumpAllDimensions = DEFAULT_JUMP_ALL_DIMENSIONS;
 
     int volumeX1000 = DEFAULT_VOLUME_X1000;
     std::string dimensionDynamicPan = "None";
@@ -100,6 +122,7 @@ public:
     void SetCrossfadeSampleLength ( int length ) { crossfadeSampleLength = length; }
     void SetMaxJumpDistanceSpaceX1000 ( int distanceX1000 ) { maxJumpDistanceSpaceX1000 = distanceX1000; }
     void SetMaxJumpTargets ( int targets ) { maxJumpTargets = targets; }
+    void SetJumpAllDimensions ( bool all ) { jumpAllDimensions = all; }
 
     void SetVolumeX1000 ( int volumeX1000 ) { this->volumeX1000 = volumeX1000; }
     void SetDimensionDynamicPan ( const std::string& dimension ) { dimensionDynamicPan = dimension; }
@@ -124,6 +147,7 @@ public:
     int GetMaxJumpDistanceSpaceX1000 ( ) const { return maxJumpDistanceSpaceX1000; }
         float GetMaxJumpDistanceSpace ( ) const { return static_cast<float>(maxJumpDistanceSpaceX1000) / 1000.0; }
     int GetMaxJumpTargets ( ) const { return maxJumpTargets; }
+    bool GetJumpAllDimensions ( ) const { return jumpAllDimensions; }
 
     int GetVolumeX1000 ( ) const { return volumeX1000; }
         float GetVolume ( ) const { return static_cast<float>(volumeX1000) / 1000.0; }
@@ -184,8 +208,36 @@ struct AudioPlayhead {
     size_t jumpSampleIndex = 0;
     size_t crossfadeCurrentSample = 0;
     size_t crossfadeSampleLength = 0;
-    
-    std::queue<size_t> triggerSamplePoints;
+
+    // streamed storage only
+    int streamSlot = -1; // feeds the current file position
+    int jumpStreamSlot = -1; // prefetches the pending jump target, or the loop point
+    bool jumpPending = false; // jump chosen at the last trigger, taken at the next one if its audio has arrived
+    bool loopPrefetched = false;
+
+    // cached storage only
+    const float* cachedSamples = nullptr; // pinned in the audio cache while the playhead is on this file
+    const float* jumpCachedSamples = nullptr; // pinned jump target
+
+    // jump planning
+    int planSlot = -1; // never jumps without one
+    size_t plannedFile = 0;
+    size_t plannedUntil = 0; // the furthest trigger point a jump target has been asked for
+
+    std::minstd_rand randomGen; // jump chances, per playhead so they don't depend on which thread renders it
+
+    size_t bufferStartOffset = 0; // frames of the current buffer to leave silent, for a playhead started part way through one
+    bool killRequested = false; // fading out, from killOffset in the buffer the kill landed in
+    size_t killOffset = 0;
+    size_t killFadeFrames = 0; // how much of the fade out is done
+    bool killed = false; // fade out finished this buffer, removed once every playhead has been processed
+};
+
+// where a playhead is, as published by the audio thread for the UI, kept trivially copyable so publishing never allocates
+struct PlayheadState {
+    size_t playheadID = 0;
+    size_t fileIndex = 0;
+    size_t sampleIndex = 0;
 };
 
 struct VisualPlayhead {
@@ -0,0 +1,291 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Utilities/HNSWIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace Acorex;
+
+void Utilities::HNSWIndex::Scratch::Prepare ( const HNSWIndex& index, size_t maxEf )
+{
+    mVisited.assign ( index.Size ( ), 0 );
+    mVisitEpoch = 0;
+    mCandidates.reserve ( index.Size ( ) + 1 ); // each node is queued at most once per search
+    mBest.reserve ( maxEf + 1 );
+    mMaxEf = maxEf;
+}
+
+void Utilities::HNSWIndex::Build ( std::vector<float> data, size_t dimensions, size_t links, size_t efConstruction, uint32_t seed )
+{
+    Clear ( );
+    if ( dimensions == 0 || links < 2 ) { return; }
+
+    mData = std::move ( data );
+    mDimensions = dimensions;
+    mCount = mData.size ( ) / dimensions;
+    mMaxLinks = links;
+    mMaxLinksBottom = links * 2;
+
+    mBottomLinks.assign ( mCount * ( mMaxLinksBottom + 1 ), 0 );
+    mUpperLinks.resize ( mCount );
+    mLevels.assign ( mCount, 0 );
+
+    // each layer up holds roughly 1 / links of the one below
+    std::mt19937 randomGen ( seed );
+    std::uniform_real_distribution<double> unit ( std::numeric_limits<double>::min ( ), 1.0 );
+    double levelScale = 1.0 / std::log ( (double)links );
+
+    Scratch scratch;
+    scratch.Prepare ( *this, efConstruction );
+    std::vector<Candidate> neighbours;
+    std::vector<Candidate> workspace;
+
+    for ( uint32_t node = 0; node < mCount; node++ )
+    {
+        int level = std::min ( (int)( -std::log ( unit ( randomGen ) ) * levelScale ), 32 );
+        mLevels[node] = (uint8_t)level;
+        if ( level > 0 ) { mUpperLinks[node].assign ( level * ( mMaxLinks + 1 ), 0 ); }
+
+        if ( mTopLevel < 0 ) { mEntryPoint = node; mTopLevel = level; continue; }
+
+        const float* point = GetPoint ( node );
+        uint32_t entry = GreedyDescend ( point, mEntryPoint, mTopLevel, level );
+
+        for ( int layer = std::min ( level, mTopLevel ); layer >= 0; layer-- )
+        {
+            LayerSearch search { point, efConstruction, std::numeric_limits<float>::max ( ), 0, nullptr, nullptr };
+            SearchLayer ( search, entry, layer, scratch );
+
+            neighbours.assign ( scratch.mBest.begin ( ), scratch.mBest.end ( ) );
+            SelectNeighbours ( neighbours, mMaxLinks );
+            if ( !neighbours.empty ( ) ) { entry = neighbours[0].node; } // nearest first after selection
+
+            uint32_t* nodeLinks = GetLinks ( node, layer );
+            nodeLinks[0] = (uint32_t)neighbours.size ( );
+            for ( size_t i = 0; i < neighbours.size ( ); i++ )
+            {
+                nodeLinks[i + 1] = neighbours[i].node;
+                Link ( neighbours[i].node, node, layer, workspace );
+            }
+        }
+
+        if ( level > mTopLevel ) { mTopLevel = level; mEntryPoint = node; }
+    }
+}
+
+void Utilities::HNSWIndex::Clear ( )
+{
+    mData.clear ( );
+    mDimensions = 0;
+    mCount = 0;
+    mBottomLinks.clear ( );
+    mUpperLinks.clear ( );
+    mLevels.clear ( );
+    mEntryPoint = 0;
+    mTopLevel = -1;
+}
+
+size_t Utilities::HNSWIndex::Search ( const float* query, size_t k, size_t ef, Scratch& scratch, Result* results ) const
+{
+    if ( k == 0 || mCount == 0 || !scratch.IsPreparedFor ( *this, 1 ) ) { return 0; }
+
+    // ef is capped by what the scratch was prepared for, so the search never has to grow it
+    ef = std::min ( std::max ( ef, k ), scratch.mMaxEf );
+
+    uint32_t entry = GreedyDescend ( query, mEntryPoint, mTopLevel, 0 );
+    LayerSearch search { query, ef, std::numeric_limits<float>::max ( ), 0, nullptr, nullptr };
+    SearchLayer ( search, entry, 0, scratch );
+
+    std::sort_heap ( scratch.mBest.begin ( ), scratch.mBest.end ( ), [] ( const Candidate& a, const Candidate& b ) { return a.distanceSquared < b.distanceSquared; } );
+
+    size_t found = std::min ( k, scratch.mBest.size ( ) );
+    for ( size_t i = 0; i < found; i++ ) { results[i] = { scratch.mBest[i].node, std::sqrt ( scratch.mBest[i].distanceSquared ) }; }
+    return found;
+}
+
+bool Utilities::HNSWIndex::SearchMatching ( const float* query, size_t ef, float maxDistance, size_t maxVisits, AcceptFunction accept, void* context, Scratch& scratch, Result& result ) const
+{
+    if ( mCount == 0 || !scratch.IsPreparedFor ( *this, 1 ) ) { return false; }
+
+    ef = std::min ( std::max ( ef, (size_t)1 ), scratch.mMaxEf );
+
+    uint32_t entry = GreedyDescend ( query, mEntryPoint, mTopLevel, 0 );
+    LayerSearch search { query, ef, maxDistance > 0.0f ? maxDistance * maxDistance : std::numeric_limits<float>::max ( ), maxVisits, accept, context };
+    SearchLayer ( search, entry, 0, scratch );
+
+    if ( scratch.mBest.empty ( ) ) { return false; }
+
+    const Candidate& nearest = *std::min_element ( scratch.mBest.begin ( ), scratch.mBest.end ( ), [] ( const Candidate& a, const Candidate& b ) { return a.distanceSquared < b.distanceSquared; } );
+    result = { nearest.node, std::sqrt ( nearest.distanceSquared ) };
+    return true;
+}
+
+float Utilities::HNSWIndex::DistanceSquared ( const float* a, const float* b ) const
+{
+    float sum = 0.0f;
+#pragma omp simd reduction(+:sum)
+    for ( size_t dim = 0; dim < mDimensions; dim++ )
+    {
+        float difference = a[dim] - b[dim];
+        sum += difference * difference;
+    }
+    return sum;
+}
+
+uint32_t* Utilities::HNSWIndex::GetLinks ( uint32_t node, int level )
+{
+    if ( level == 0 ) { return &mBottomLinks[node * ( mMaxLinksBottom + 1 )]; }
+    return &mUpperLinks[node][( level - 1 ) * ( mMaxLinks + 1 )];
+}
+
+const uint32_t* Utilities::HNSWIndex::GetLinks ( uint32_t node, int level ) const
+{
+    if ( level == 0 ) { return &mBottomLinks[node * ( mMaxLinksBottom + 1 )]; }
+    return &mUpperLinks[node][( level - 1 ) * ( mMaxLinks + 1 )];
+}
+
+uint32_t Utilities::HNSWIndex::GreedyDescend ( const float* query, uint32_t entry, int fromLevel, int toLevel ) const
+{
+    uint32_t current = entry;
+    float currentDistance = DistanceSquared ( current, query );
+
+    for ( int level = fromLevel; level > toLevel; level-- )
+    {
+        bool moved = true;
+        while ( moved )
+        {
+            moved = false;
+            const uint32_t* links = GetLinks ( current, level );
+            for ( uint32_t i = 1; i <= links[0]; i++ )
+            {
+                float distance = DistanceSquared ( links[i], query );
+                if ( distance < currentDistance ) { current = links[i]; currentDistance = distance; moved = true; }
+            }
+        }
+    }
+
+    return current;
+}
+
+void Utilities::HNSWIndex::SearchLayer ( const LayerSearch& search, uint32_t entry, int level, Scratch& scratch ) const
+{
+    auto nearerFirst = [] ( const Candidate& a, const Candidate& b ) { return a.distanceSquared > b.distanceSquared; };
+    auto furtherFirst = [] ( const Candidate& a, const Candidate& b ) { return a.distanceSquared < b.distanceSquared; };
+
+    if ( ++scratch.mVisitEpoch == 0 ) { std::fill ( scratch.mVisited.begin ( ), scratch.mVisited.end ( ), 0 ); scratch.mVisitEpoch = 1; }
+    uint32_t epoch = scratch.mVisitEpoch;
+
+    std::vector<Candidate>& candidates = scratch.mCandidates;
+    std::vector<Candidate>& best = scratch.mBest;
+    candidates.clear ( );
+    best.clear ( );
+
+    float entryDistance = DistanceSquared ( entry, search.query );
+    scratch.mVisited[entry] = epoch;
+    size_t visits = 1;
+
+    candidates.push_back ( { entryDistance, entry } );
+    if ( entryDistance <= search.limitSquared && ( search.accept == nullptr || search.accept ( entry, std::sqrt ( entryDistance ), search.context ) ) )
+    {
+        best.push_back ( { entryDistance, entry } );
+    }
+    float lowerBound = best.empty ( ) ? std::numeric_limits<float>::max ( ) : best.front ( ).distanceSquared;
+
+    while ( !candidates.empty ( ) )
+    {
+        std::pop_heap ( candidates.begin ( ), candidates.end ( ), nearerFirst );
+        Candidate current = candidates.back ( );
+        candidates.pop_back ( );
+
+        // with a filter, keep walking until ef accepted points are held, rejected ones still lead somewhere
+        if ( current.distanceSquared > lowerBound && ( best.size ( ) >= search.ef || search.accept == nullptr ) ) { break; }
+        if ( current.distanceSquared > search.limitSquared ) { break; }
+        if ( search.maxVisits > 0 && visits >= search.maxVisits ) { break; }
+
+        const uint32_t* links = GetLinks ( current.node, level );
+        for ( uint32_t i = 1; i <= links[0]; i++ )
+        {
+            uint32_t neighbour = links[i];
+            if ( scratch.mVisited[neighbour] == epoch ) { continue; }
+            scratch.mVisited[neighbour] = epoch;
+            visits++;
+
+            float distance = DistanceSquared ( neighbour, search.query );
+            if ( distance > search.limitSquared ) { continue; }
+            if ( best.size ( ) >= search.ef && distance >= lowerBound ) { continue; }
+
+            candidates.push_back ( { distance, neighbour } );
+            std::push_heap ( candidates.begin ( ), candidates.end ( ), nearerFirst );
+
+            if ( search.accept != nullptr && !search.accept ( neighbour, std::sqrt ( distance ), search.context ) ) { continue; }
+
+            best.push_back ( { distance, neighbour } );
+            std::push_heap ( best.begin ( ), best.end ( ), furtherFirst );
+            if ( best.size ( ) > search.ef )
+            {
+                std::pop_heap ( best.begin ( ), best.end ( ), furtherFirst );
+                best.pop_back ( );
+            }
+            lowerBound = best.front ( ).distanceSquared;
+        }
+    }
+}
+
+void Utilities::HNSWIndex::SelectNeighbours ( std::vector<Candidate>& candidates, size_t maxCount ) const
+{
+    std::sort ( candidates.begin ( ), candidates.end ( ), [] ( const Candidate& a, const Candidate& b ) { return a.distanceSquared < b.distanceSquared; } );
+
+    // a candidate nearer to an already kept neighbour than to the node is reachable through it, so skipping it spreads the links out
+    size_t kept = 0;
+    for ( size_t i = 0; i < candidates.size ( ) && kept < maxCount; i++ )
+    {
+        bool diverse = true;
+        for ( size_t j = 0; j < kept && diverse; j++ )
+        {
+            diverse = DistanceSquared ( GetPoint ( candidates[i].node ), GetPoint ( candidates[j].node ) ) >= candidates[i].distanceSquared;
+        }
+        if ( diverse ) { candidates[kept++] = candidates[i]; }
+    }
+    candidates.resize ( kept );
+}
+
+void Utilities::HNSWIndex::Link ( uint32_t node, uint32_t neighbour, int level, std::vector<Candidate>& workspace )
+{
+    uint32_t* links = GetLinks ( node, level );
+    size_t maxLinks = GetMaxLinks ( level );
+
+    if ( links[0] < maxLinks )
+    {
+        links[++links[0]] = neighbour;
+        return;
+    }
+
+    // full, so the new link competes with the existing ones
+    const float* point = GetPoint ( node );
+    workspace.clear ( );
+    workspace.push_back ( { DistanceSquared ( neighbour, point ), neighbour } );
+    for ( uint32_t i = 1; i <= links[0]; i++ ) { workspace.push_back ( { DistanceSquared ( links[i], point ), links[i] } ); }
+
+    SelectNeighbours ( workspace, maxLinks );
+
+    links[0] = (uint32_t)workspace.size ( );
+    for ( size_t i = 0; i < workspace.size ( ); i++ ) { links[i + 1] = workspace[i].node; }
+}
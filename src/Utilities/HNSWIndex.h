@@ -0,0 +1,125 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Acorex {
+namespace Utilities {
+
+// approximate nearest neighbour index over points with any number of dimensions (hierarchical navigable small world graph)
+// each point links to its nearest few on the bottom layer, and a thinning random subset also sits on the layers above, searches descend greedily from the top
+// payloads are the point's row in the data given to Build
+// searches never allocate, all of their state lives in a Scratch prepared by the caller, one Scratch per searching thread
+class HNSWIndex {
+public:
+    struct Result {
+        uint32_t payload;
+        float distance;
+    };
+
+    using AcceptFunction = bool (*) ( uint32_t payload, float distance, void* context );
+
+    class Scratch {
+    public:
+        void Prepare ( const HNSWIndex& index, size_t maxEf );
+        bool IsPreparedFor ( const HNSWIndex& index, size_t ef ) const { return mVisited.size ( ) >= index.Size ( ) && mMaxEf >= ef; }
+
+    private:
+        friend class HNSWIndex;
+
+        struct Candidate {
+            float distanceSquared;
+            uint32_t node;
+        };
+
+        std::vector<uint32_t> mVisited; // [node], the search that last visited it
+        uint32_t mVisitEpoch = 0;
+        std::vector<Candidate> mCandidates; // min heap of nodes still to expand
+        std::vector<Candidate> mBest; // max heap of the ef best so far
+        size_t mMaxEf = 0;
+    };
+
+    HNSWIndex ( ) { }
+    ~HNSWIndex ( ) { }
+
+    // data is row major, points * dimensions
+    // links is the out degree on the upper layers (twice this on the bottom layer), efConstruction the search width used while inserting
+    void Build ( std::vector<float> data, size_t dimensions, size_t links = 16, size_t efConstruction = 100, uint32_t seed = 1 );
+    void Clear ( );
+
+    size_t Size ( ) const { return mCount; }
+    size_t Dimensions ( ) const { return mDimensions; }
+    bool Empty ( ) const { return mCount == 0; }
+    const float* GetPoint ( size_t point ) const { return &mData[point * mDimensions]; }
+
+    // returns how many results were written (at most k), sorted nearest first, ef >= k trades speed for recall
+    size_t Search ( const float* query, size_t k, size_t ef, Scratch& scratch, Result* results ) const;
+    // the nearest point that accept ( payload, distance ) returns true for, rejected points are still walked through but never returned
+    // the search gives up beyond maxDistance (<= 0 for no limit) or after maxVisits distance evaluations (0 for no limit), bounding its cost when little is accepted
+    bool SearchMatching ( const float* query, size_t ef, float maxDistance, size_t maxVisits, AcceptFunction accept, void* context, Scratch& scratch, Result& result ) const;
+    template <typename Accept>
+    bool SearchMatching ( const float* query, size_t ef, float maxDistance, size_t maxVisits, Accept& accept, Scratch& scratch, Result& result ) const
+    {
+        return SearchMatching ( query, ef, maxDistance, maxVisits,
+                                [] ( uint32_t payload, float distance, void* context ) { return ( *static_cast<Accept*> ( context ) ) ( payload, distance ); },
+                                &accept, scratch, result );
+    }
+
+private:
+    using Candidate = Scratch::Candidate;
+
+    struct LayerSearch {
+        const float* query;
+        size_t ef;
+        float limitSquared; // candidates beyond this are never expanded
+        size_t maxVisits;
+        AcceptFunction accept; // nullptr accepts everything
+        void* context;
+    };
+
+    float DistanceSquared ( const float* a, const float* b ) const;
+    float DistanceSquared ( uint32_t node, const float* query ) const { return DistanceSquared ( GetPoint ( node ), query ); }
+
+    uint32_t* GetLinks ( uint32_t node, int level ); // [0] is the count, then the linked nodes
+    const uint32_t* GetLinks ( uint32_t node, int level ) const;
+    size_t GetMaxLinks ( int level ) const { return level == 0 ? mMaxLinksBottom : mMaxLinks; }
+
+    uint32_t GreedyDescend ( const float* query, uint32_t entry, int fromLevel, int toLevel ) const;
+    void SearchLayer ( const LayerSearch& search, uint32_t entry, int level, Scratch& scratch ) const; // leaves the ef best in scratch.mBest
+    void SelectNeighbours ( std::vector<Candidate>& candidates, size_t maxCount ) const; // sorts by distance, then keeps those not better reached through a kept one
+    void Link ( uint32_t node, uint32_t neighbour, int level, std::vector<Candidate>& workspace );
+
+    std::vector<float> mData;
+    size_t mDimensions = 0;
+    size_t mCount = 0;
+
+    size_t mMaxLinks = 0;
+    size_t mMaxLinksBottom = 0;
+    std::vector<uint32_t> mBottomLinks; // [node * ( mMaxLinksBottom + 1 )]
+    std::vector<std::vector<uint32_t>> mUpperLinks; // [node][( level - 1 ) * ( mMaxLinks + 1 )]
+    std::vector<uint8_t> mLevels; // [node], highest layer the node is on
+
+    uint32_t mEntryPoint = 0;
+    int mTopLevel = -1;
+};
+
+} // namespace Utilities
+} // namespace Acorex
@@ -0,0 +1,208 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Utilities/MixKernels.h"
+#include "Utilities/Data.h"
+
+#include <ofSoundBuffer.h>
+#include <ofLog.h>
+#include <ofMath.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cmath>
+
+using namespace Acorex;
+
+namespace {
+
+inline float ToFloat ( float sample ) { return sample; }
+inline float ToFloat ( int16_t sample ) { return Utilities::Int16ToFloatSample ( sample ); }
+
+template <typename SampleType>
+void PanToStereoBlock ( const SampleType* source, size_t frames, float gainL, float gainR, float* stereo )
+{
+#pragma omp simd
+    for ( size_t i = 0; i < frames; i++ )
+    {
+        float sample = ToFloat ( source[i] );
+        stereo[i * 2] = sample * gainL;
+        stereo[i * 2 + 1] = sample * gainR;
+    }
+}
+
+template <typename SampleType>
+void CrossfadeToStereoBlock (   const SampleType* sourceA, const SampleType* sourceB, size_t frames, float progress, float progressStep,
+                                float panStart, float panEnd, float panningStrength, float* stereo )
+{
+#pragma omp simd
+    for ( size_t i = 0; i < frames; i++ )
+    {
+        float position = progress + progressStep * (float)i;
+        float sample = ToFloat ( sourceA[i] ) * Utilities::MixKernels::EqualPowerGain ( 1.0f - position )
+                     + ToFloat ( sourceB[i] ) * Utilities::MixKernels::EqualPowerGain ( position );
+
+        float gainL, gainR;
+        Utilities::MixKernels::PanGains ( panStart + ( panEnd - panStart ) * position, panningStrength, gainL, gainR );
+
+        stereo[i * 2] = sample * gainL;
+        stereo[i * 2 + 1] = sample * gainR;
+    }
+}
+
+} // namespace
+
+void Utilities::MixKernels::PanToStereo ( const float* source, size_t frames, float gainL, float gainR, float* stereo )
+{
+    PanToStereoBlock ( source, frames, gainL, gainR, stereo );
+}
+
+void Utilities::MixKernels::PanToStereo ( const int16_t* source, size_t frames, float gainL, float gainR, float* stereo )
+{
+    PanToStereoBlock ( source, frames, gainL, gainR, stereo );
+}
+
+void Utilities::MixKernels::CrossfadeToStereo ( const float* sourceA, const float* sourceB, size_t frames, float progress, float progressStep,
+                                                float panStart, float panEnd, float panningStrength, float* stereo )
+{
+    CrossfadeToStereoBlock ( sourceA, sourceB, frames, progress, progressStep, panStart, panEnd, panningStrength, stereo );
+}
+
+void Utilities::MixKernels::CrossfadeToStereo ( const int16_t* sourceA, const int16_t* sourceB, size_t frames, float progress, float progressStep,
+                                                float panStart, float panEnd, float panningStrength, float* stereo )
+{
+    CrossfadeToStereoBlock ( sourceA, sourceB, frames, progress, progressStep, panStart, panEnd, panningStrength, stereo );
+}
+
+void Utilities::MixKernels::FadeOut ( float* stereo, size_t frames, float progress, float progressStep )
+{
+#pragma omp simd
+    for ( size_t i = 0; i < frames; i++ )
+    {
+        float gain = EqualPowerGain ( std::max ( 1.0f - progress - progressStep * (float)i, 0.0f ) );
+        stereo[i * 2] *= gain;
+        stereo[i * 2 + 1] *= gain;
+    }
+}
+
+void Utilities::MixKernels::Accumulate ( const float* source, size_t samples, float* destination )
+{
+#pragma omp simd
+    for ( size_t i = 0; i < samples; i++ ) { destination[i] += source[i]; }
+}
+
+void Utilities::MixKernels::Scale ( float* samples, size_t count, float gain )
+{
+#pragma omp simd
+    for ( size_t i = 0; i < count; i++ ) { samples[i] *= gain; }
+}
+
+void Utilities::MixKernels::Benchmark ( )
+{
+    // one playhead's share of a buffer: half of it crossfading into a jump, half playing on, panned, then summed into the output
+    const size_t bufferFrames = 512;
+    const double sampleRate = 44100.0;
+    const size_t crossfadeLength = 16384;
+    const size_t repetitions = 20000;
+
+    std::mt19937 randomGen ( 1 );
+    std::uniform_real_distribution<float> noise ( -1.0f, 1.0f );
+    std::vector<float> sourceA ( bufferFrames ), sourceB ( bufferFrames );
+    for ( size_t i = 0; i < bufferFrames; i++ ) { sourceA[i] = noise ( randomGen ); sourceB[i] = noise ( randomGen ); }
+
+    const float panStart = 0.2f, panEnd = 0.7f, panningStrength = 1.0f;
+    const size_t half = bufferFrames / 2;
+
+    ofSoundBuffer voiceBuffer, outBuffer;
+    voiceBuffer.allocate ( bufferFrames, 2 );
+    outBuffer.allocate ( bufferFrames, 2 );
+
+    double seconds[2] = { 0.0, 0.0 };
+    double checksum[2] = { 0.0, 0.0 };
+    for ( int method = 0; method < 2; method++ )
+    {
+        std::fill ( outBuffer.getBuffer ( ).begin ( ), outBuffer.getBuffer ( ).end ( ), 0.0f );
+
+        auto start = std::chrono::steady_clock::now ( );
+        for ( size_t repetition = 0; repetition < repetitions; repetition++ )
+        {
+            size_t crossfadeSample = ( repetition * half ) % crossfadeLength;
+
+            if ( method == 0 )
+            {
+                // per sample through the accessors, as the audio callback used to
+                for ( size_t i = 0; i < bufferFrames; i++ ) { voiceBuffer.getSample ( i, 0 ) = 0.0f; voiceBuffer.getSample ( i, 1 ) = 0.0f; }
+
+                for ( size_t i = 0; i < half; i++ )
+                {
+                    float crossfadeProgress = (float)( crossfadeSample + i ) / (float)crossfadeLength;
+                    float sample = sourceA[i] * (float)cos ( crossfadeProgress * 0.5 * M_PI ) + sourceB[i] * (float)sin ( crossfadeProgress * 0.5 * M_PI );
+                    float pan = panStart + ( panEnd - panStart ) * crossfadeProgress;
+                    float panGainL = 1.0f - panningStrength * ( 1.0f - (float)cos ( pan * 0.5 * M_PI ) );
+                    float panGainR = 1.0f - panningStrength * ( 1.0f - (float)sin ( pan * 0.5 * M_PI ) );
+                    voiceBuffer.getSample ( i, 0 ) = sample * panGainL;
+                    voiceBuffer.getSample ( i, 1 ) = sample * panGainR;
+                }
+
+                float panGainL = 1.0f - panningStrength * ( 1.0f - (float)cos ( panEnd * 0.5 * M_PI ) );
+                float panGainR = 1.0f - panningStrength * ( 1.0f - (float)sin ( panEnd * 0.5 * M_PI ) );
+                for ( size_t i = half; i < bufferFrames; i++ )
+                {
+                    voiceBuffer.getSample ( i, 0 ) = sourceB[i] * panGainL;
+                    voiceBuffer.getSample ( i, 1 ) = sourceB[i] * panGainR;
+                }
+
+                for ( size_t i = 0; i < bufferFrames; i++ )
+                {
+                    outBuffer.getSample ( i, 0 ) += voiceBuffer.getSample ( i, 0 );
+                    outBuffer.getSample ( i, 1 ) += voiceBuffer.getSample ( i, 1 );
+                }
+            }
+            else
+            {
+                float* voice = voiceBuffer.getBuffer ( ).data ( );
+                std::fill ( voice, voice + bufferFrames * 2, 0.0f );
+
+                CrossfadeToStereo ( sourceA.data ( ), sourceB.data ( ), half, (float)crossfadeSample / (float)crossfadeLength, 1.0f / (float)crossfadeLength,
+                                    panStart, panEnd, panningStrength, voice );
+
+                float panGainL, panGainR;
+                PanGains ( panEnd, panningStrength, panGainL, panGainR );
+                PanToStereo ( sourceB.data ( ) + half, bufferFrames - half, panGainL, panGainR, voice + half * 2 );
+
+                Accumulate ( voice, bufferFrames * 2, outBuffer.getBuffer ( ).data ( ) );
+            }
+        }
+        seconds[method] = std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - start ).count ( );
+
+        for ( float sample : outBuffer.getBuffer ( ) ) { checksum[method] += std::abs ( sample ); }
+    }
+
+    double bufferSeconds = (double)bufferFrames / sampleRate;
+    double voicesPerCore[2];
+    for ( int method = 0; method < 2; method++ )
+    {
+        voicesPerCore[method] = bufferSeconds / std::max ( seconds[method] / (double)repetitions, 1e-12 );
+    }
+
+    ofLogNotice ( "MixKernels" ) << bufferFrames << " frame buffers at " << sampleRate << " Hz, each voice half crossfading, panned: "
+        << "per sample " << (size_t)voicesPerCore[0] << " voices per core | "
+        << "block kernels " << (size_t)voicesPerCore[1] << " voices per core, "
+        << ( voicesPerCore[1] / std::max ( voicesPerCore[0], 1e-9 ) ) << "x | "
+        << "output difference " << std::abs ( checksum[1] - checksum[0] ) / std::max ( checksum[0], 1e-9 );
+}
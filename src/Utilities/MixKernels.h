@@ -0,0 +1,65 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+namespace Acorex {
+namespace Utilities {
+
+// block kernels for mixing playheads on the audio thread, stereo buffers are interleaved left / right as ofSoundBuffer holds them
+// plain loops left for the compiler to vectorise, with equal power gains from a polynomial rather than cos and sin every sample
+class MixKernels {
+public:
+    // sin ( position * pi / 2 ) for position in 0-1, within 4e-6, EqualPowerGain ( 1 - position ) is the matching cos
+    static inline float EqualPowerGain ( float position )
+    {
+        float x = std::min ( std::max ( position, 0.0f ), 1.0f );
+        float x2 = x * x;
+        return x * ( 1.5707963f + x2 * ( -0.6459641f + x2 * ( 0.0796926f + x2 * ( -0.0046818f + x2 * 0.0001604f ) ) ) );
+    }
+
+    // the pan law: an equal power pan from position (0 left, 1 right), pulled towards unity gain as strength falls to 0
+    static inline void PanGains ( float position, float strength, float& gainL, float& gainR )
+    {
+        gainL = 1.0f - strength * ( 1.0f - EqualPowerGain ( 1.0f - position ) );
+        gainR = 1.0f - strength * ( 1.0f - EqualPowerGain ( position ) );
+    }
+
+    // mono source to stereo, overwriting
+    static void PanToStereo ( const float* source, size_t frames, float gainL, float gainR, float* stereo );
+    static void PanToStereo ( const int16_t* source, size_t frames, float gainL, float gainR, float* stereo );
+
+    // equal power crossfade from a to b to stereo, overwriting, progress runs from progress by progressStep per frame
+    // the pan moves from panStart to panEnd along with progress, a panning strength of 0 leaves both channels at unity gain
+    static void CrossfadeToStereo ( const float* sourceA, const float* sourceB, size_t frames, float progress, float progressStep,
+                                    float panStart, float panEnd, float panningStrength, float* stereo );
+    static void CrossfadeToStereo ( const int16_t* sourceA, const int16_t* sourceB, size_t frames, float progress, float progressStep,
+                                    float panStart, float panEnd, float panningStrength, float* stereo );
+
+    static void FadeOut ( float* stereo, size_t frames, float progress, float progressStep ); // quarter cosine down from 1 - progress, a fade can be split across buffers
+    static void Accumulate ( const float* source, size_t samples, float* destination );
+    static void Scale ( float* samples, size_t count, float gain );
+
+    static void Benchmark ( ); // times a playhead's share of a buffer through these kernels and through the per sample path they replaced, results go to the log
+};
+
+} // namespace Utilities
+} // namespace Acorex
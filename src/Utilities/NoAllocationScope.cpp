@@ -0,0 +1,106 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Utilities/NoAllocationScope.h"
+#include "Utilities/TemporaryDefaults.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+using namespace Acorex;
+
+namespace {
+    thread_local int tNoAllocationDepth = 0;
+}
+
+Utilities::NoAllocationScope::NoAllocationScope ( )
+{
+    tNoAllocationDepth++;
+}
+
+Utilities::NoAllocationScope::~NoAllocationScope ( )
+{
+    tNoAllocationDepth--;
+}
+
+bool Utilities::NoAllocationScope::Active ( )
+{
+    return tNoAllocationDepth > 0;
+}
+
+#if DEFAULT_CHECK_AUDIO_THREAD_ALLOCATIONS && !defined ( NDEBUG )
+
+// the aligned forms are left to the standard library, nothing on the audio path uses over-aligned types
+
+void* operator new ( std::size_t size )
+{
+    assert ( tNoAllocationDepth == 0 && "memory allocated inside a NoAllocationScope" );
+
+    void* memory = std::malloc ( size > 0 ? size : 1 );
+    if ( memory == nullptr ) { throw std::bad_alloc ( ); }
+    return memory;
+}
+
+void* operator new[] ( std::size_t size )
+{
+    return operator new ( size );
+}
+
+void* operator new ( std::size_t size, const std::nothrow_t& ) noexcept
+{
+    assert ( tNoAllocationDepth == 0 && "memory allocated inside a NoAllocationScope" );
+    return std::malloc ( size > 0 ? size : 1 );
+}
+
+void* operator new[] ( std::size_t size, const std::nothrow_t& tag ) noexcept
+{
+    return operator new ( size, tag );
+}
+
+void operator delete ( void* memory ) noexcept
+{
+    assert ( ( memory == nullptr || tNoAllocationDepth == 0 ) && "memory freed inside a NoAllocationScope" );
+    std::free ( memory );
+}
+
+void operator delete[] ( void* memory ) noexcept
+{
+    operator delete ( memory );
+}
+
+void operator delete ( void* memory, std::size_t ) noexcept
+{
+    operator delete ( memory );
+}
+
+void operator delete[] ( void* memory, std::size_t ) noexcept
+{
+    operator delete ( memory );
+}
+
+void operator delete ( void* memory, const std::nothrow_t& ) noexcept
+{
+    operator delete ( memory );
+}
+
+void operator delete[] ( void* memory, const std::nothrow_t& ) noexcept
+{
+    operator delete ( memory );
+}
+
+#endif
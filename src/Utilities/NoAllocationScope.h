@@ -0,0 +1,38 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+namespace Acorex {
+namespace Utilities {
+
+// marks code that must not allocate or free memory, such as the audio callback, for as long as it is in scope on this thread
+// with DEFAULT_CHECK_AUDIO_THREAD_ALLOCATIONS set in a debug build the global operator new and delete are replaced, and assert inside one
+// otherwise it only counts, at no cost worth measuring
+class NoAllocationScope {
+public:
+    NoAllocationScope ( );
+    ~NoAllocationScope ( );
+
+    NoAllocationScope ( const NoAllocationScope& ) = delete;
+    NoAllocationScope& operator= ( const NoAllocationScope& ) = delete;
+
+    static bool Active ( ); // whether the calling thread is inside one
+};
+
+} // namespace Utilities
+} // namespace Acorex
@@ -0,0 +1,412 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Utilities/PointKDTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace Acorex;
+
+void Utilities::PointKDTree::Build ( const std::vector<glm::vec3>& points, const std::vector<uint32_t>& payloads )
+{
+    size_t count = std::min ( points.size ( ), payloads.size ( ) );
+
+    mNodes.resize ( count );
+    mSplitAxes.assign ( count, 0 );
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+        mNodes[i] = { { points[i].x, points[i].y, points[i].z }, payloads[i] };
+    }
+
+    mBounds = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+    for ( size_t i = 0; i < count; i++ )
+    {
+        for ( int axis = 0; axis < 3; axis++ )
+        {
+            mBounds.minimum[axis] = i == 0 ? mNodes[i].position[axis] : std::min ( mBounds.minimum[axis], mNodes[i].position[axis] );
+            mBounds.maximum[axis] = i == 0 ? mNodes[i].position[axis] : std::max ( mBounds.maximum[axis], mNodes[i].position[axis] );
+        }
+    }
+
+    BuildRange ( 0, count );
+}
+
+void Utilities::PointKDTree::Clear ( )
+{
+    mNodes.clear ( );
+    mSplitAxes.clear ( );
+}
+
+void Utilities::PointKDTree::BuildRange ( size_t begin, size_t end )
+{
+    while ( end - begin > 1 )
+    {
+        // split on the axis with the widest spread, an unused axis (z in 2D) never gets picked
+        float minimum[3] = { std::numeric_limits<float>::max ( ), std::numeric_limits<float>::max ( ), std::numeric_limits<float>::max ( ) };
+        float maximum[3] = { std::numeric_limits<float>::lowest ( ), std::numeric_limits<float>::lowest ( ), std::numeric_limits<float>::lowest ( ) };
+        for ( size_t i = begin; i < end; i++ )
+        {
+            for ( int axis = 0; axis < 3; axis++ )
+            {
+                minimum[axis] = std::min ( minimum[axis], mNodes[i].position[axis] );
+                maximum[axis] = std::max ( maximum[axis], mNodes[i].position[axis] );
+            }
+        }
+
+        int splitAxis = 0;
+        for ( int axis = 1; axis < 3; axis++ )
+        {
+            if ( maximum[axis] - minimum[axis] > maximum[splitAxis] - minimum[splitAxis] ) { splitAxis = axis; }
+        }
+
+        size_t middle = begin + (end - begin) / 2;
+        std::nth_element ( mNodes.begin ( ) + begin, mNodes.begin ( ) + middle, mNodes.begin ( ) + end,
+            [splitAxis] ( const Node& a, const Node& b ) { return a.position[splitAxis] < b.position[splitAxis]; } );
+        mSplitAxes[middle] = (uint8_t)splitAxis;
+
+        BuildRange ( begin, middle );
+        begin = middle + 1;
+    }
+}
+
+size_t Utilities::PointKDTree::KNearest ( const glm::vec3& query, size_t k, float maxDistance, Result* results ) const
+{
+    if ( k == 0 || mNodes.empty ( ) ) { return 0; }
+
+    float queryPosition[3] = { query.x, query.y, query.z };
+    KNearestSearch search { queryPosition, results, k, 0,
+                            maxDistance > 0.0f ? maxDistance * maxDistance : std::numeric_limits<float>::max ( ) };
+
+    SearchKNearest ( 0, mNodes.size ( ), search );
+
+    for ( size_t i = 0; i < search.found; i++ ) { results[i].distance = std::sqrt ( results[i].distance ); }
+    return search.found;
+}
+
+void Utilities::PointKDTree::SearchKNearest ( size_t begin, size_t end, KNearestSearch& search ) const
+{
+    while ( begin < end )
+    {
+        size_t middle = begin + (end - begin) / 2;
+        const Node& node = mNodes[middle];
+
+        float distanceSquared = DistanceSquared ( node, search.query );
+        if ( distanceSquared <= search.limitSquared )
+        {
+            // insertion into the sorted results, dropping the furthest once full
+            size_t position = search.found < search.k ? search.found++ : search.k - 1;
+            while ( position > 0 && search.results[position - 1].distance > distanceSquared )
+            {
+                search.results[position] = search.results[position - 1];
+                position--;
+            }
+            search.results[position] = { node.payload, distanceSquared };
+
+            if ( search.found == search.k ) { search.limitSquared = search.results[search.k - 1].distance; }
+        }
+
+        int axis = mSplitAxes[middle];
+        float offset = search.query[axis] - node.position[axis];
+
+        if ( offset < 0.0f ) { SearchKNearest ( begin, middle, search ); }
+        else { SearchKNearest ( middle + 1, end, search ); }
+
+        if ( offset * offset > search.limitSquared ) { return; }
+
+        if ( offset < 0.0f ) { begin = middle + 1; }
+        else { end = middle; }
+    }
+}
+
+bool Utilities::PointKDTree::NearestMatching ( const glm::vec3& query, float maxDistance, AcceptFunction accept, void* context, Result& result ) const
+{
+    if ( mNodes.empty ( ) ) { return false; }
+
+    float queryPosition[3] = { query.x, query.y, query.z };
+    MatchingSearch search { queryPosition, accept, context, &result, false,
+                            maxDistance > 0.0f ? maxDistance * maxDistance : std::numeric_limits<float>::max ( ) };
+
+    SearchMatching ( 0, mNodes.size ( ), search );
+
+    if ( search.found ) { result.distance = std::sqrt ( result.distance ); }
+    return search.found;
+}
+
+void Utilities::PointKDTree::SearchMatching ( size_t begin, size_t end, MatchingSearch& search ) const
+{
+    while ( begin < end )
+    {
+        size_t middle = begin + (end - begin) / 2;
+        const Node& node = mNodes[middle];
+
+        // the limit only shrinks on acceptance, rejected points leave the search as wide as before
+        float distanceSquared = DistanceSquared ( node, search.query );
+        if ( distanceSquared <= search.limitSquared && search.accept ( node.payload, std::sqrt ( distanceSquared ), search.context ) )
+        {
+            *search.result = { node.payload, distanceSquared };
+            search.found = true;
+            search.limitSquared = distanceSquared;
+        }
+
+        int axis = mSplitAxes[middle];
+        float offset = search.query[axis] - node.position[axis];
+
+        if ( offset < 0.0f ) { SearchMatching ( begin, middle, search ); }
+        else { SearchMatching ( middle + 1, end, search ); }
+
+        if ( offset * offset > search.limitSquared ) { return; }
+
+        if ( offset < 0.0f ) { begin = middle + 1; }
+        else { end = middle; }
+    }
+}
+
+void Utilities::PointKDTree::NearestMatchingBatch ( const glm::vec3* queries, const float* maxDistances, size_t count, BatchAcceptFunction accept, void* context, Result* results, bool* found ) const
+{
+    count = std::min ( count, kMaxBatch );
+    for ( size_t query = 0; query < count; query++ ) { found[query] = false; }
+    if ( mNodes.empty ( ) || count == 0 ) { return; }
+
+    BatchSearch search;
+    search.count = count;
+    search.accept = accept;
+    search.context = context;
+    search.results = results;
+    search.found = found;
+
+    for ( size_t query = 0; query < kMaxBatch; query++ )
+    {
+        // unused lanes are kept finite so the vectorised distance loop never has to skip them
+        bool used = query < count;
+        for ( int axis = 0; axis < 3; axis++ ) { search.position[axis][query] = used ? queries[query][axis] : 0.0f; }
+        search.limitSquared[query] = used && maxDistances[query] > 0.0f ? maxDistances[query] * maxDistances[query] : std::numeric_limits<float>::max ( );
+    }
+
+    uint64_t active = count == kMaxBatch ? ~(uint64_t)0 : ( (uint64_t)1 << count ) - 1;
+    SearchMatchingBatch ( 0, mNodes.size ( ), active, search );
+
+    for ( size_t query = 0; query < count; query++ )
+    {
+        if ( found[query] ) { results[query].distance = std::sqrt ( results[query].distance ); }
+    }
+}
+
+void Utilities::PointKDTree::SearchMatchingBatch ( size_t begin, size_t end, uint64_t active, BatchSearch& search ) const
+{
+    while ( begin < end && active != 0 )
+    {
+        size_t middle = begin + (end - begin) / 2;
+        const Node& node = mNodes[middle];
+
+        float distances[kMaxBatch];
+#pragma omp simd
+        for ( size_t query = 0; query < kMaxBatch; query++ )
+        {
+            float dx = node.position[0] - search.position[0][query];
+            float dy = node.position[1] - search.position[1][query];
+            float dz = node.position[2] - search.position[2][query];
+            distances[query] = dx * dx + dy * dy + dz * dz;
+        }
+
+        for ( uint64_t remaining = active; remaining != 0; remaining &= remaining - 1 )
+        {
+            size_t query = LowestBit ( remaining );
+            if ( distances[query] > search.limitSquared[query] ) { continue; }
+            if ( !search.accept ( query, node.payload, std::sqrt ( distances[query] ), search.context ) ) { continue; }
+
+            search.results[query] = { node.payload, distances[query] };
+            search.found[query] = true;
+            search.limitSquared[query] = distances[query];
+        }
+
+        int axis = mSplitAxes[middle];
+        uint64_t nearLeft = 0;
+        for ( uint64_t remaining = active; remaining != 0; remaining &= remaining - 1 )
+        {
+            size_t query = LowestBit ( remaining );
+            if ( search.position[axis][query] < node.position[axis] ) { nearLeft |= (uint64_t)1 << query; }
+        }
+        uint64_t nearRight = active & ~nearLeft;
+
+        // the side most queries are nearest to goes first, queries on the other side join it only if still in reach
+        bool leftFirst = BitCount ( nearLeft ) >= BitCount ( nearRight );
+        uint64_t firstNear = leftFirst ? nearLeft : nearRight;
+        uint64_t secondNear = leftFirst ? nearRight : nearLeft;
+
+        uint64_t firstSet = firstNear | InReach ( secondNear, node, axis, search );
+        if ( leftFirst ) { SearchMatchingBatch ( begin, middle, firstSet, search ); }
+        else { SearchMatchingBatch ( middle + 1, end, firstSet, search ); }
+
+        // limits may have shrunk during the first side
+        active = secondNear | InReach ( firstNear, node, axis, search );
+        if ( leftFirst ) { begin = middle + 1; }
+        else { end = middle; }
+    }
+}
+
+uint64_t Utilities::PointKDTree::InReach ( uint64_t queries, const Node& node, int axis, const BatchSearch& search ) const
+{
+    uint64_t inReach = 0;
+    for ( uint64_t remaining = queries; remaining != 0; remaining &= remaining - 1 )
+    {
+        size_t query = LowestBit ( remaining );
+        float offset = search.position[axis][query] - node.position[axis];
+        if ( offset * offset <= search.limitSquared[query] ) { inReach |= (uint64_t)1 << query; }
+    }
+    return inReach;
+}
+
+size_t Utilities::PointKDTree::Radius ( const glm::vec3& query, float radius, Result* results, size_t maxResults ) const
+{
+    if ( maxResults == 0 || mNodes.empty ( ) || radius <= 0.0f ) { return 0; }
+
+    float queryPosition[3] = { query.x, query.y, query.z };
+    RadiusSearch search { queryPosition, results, maxResults, 0, radius * radius };
+
+    SearchRadius ( 0, mNodes.size ( ), search );
+
+    for ( size_t i = 0; i < search.found; i++ ) { results[i].distance = std::sqrt ( results[i].distance ); }
+    return search.found;
+}
+
+void Utilities::PointKDTree::SearchRadius ( size_t begin, size_t end, RadiusSearch& search ) const
+{
+    while ( begin < end && search.found < search.maxResults )
+    {
+        size_t middle = begin + (end - begin) / 2;
+        const Node& node = mNodes[middle];
+
+        float distanceSquared = DistanceSquared ( node, search.query );
+        if ( distanceSquared <= search.radiusSquared )
+        {
+            search.results[search.found++] = { node.payload, distanceSquared };
+        }
+
+        int axis = mSplitAxes[middle];
+        float offset = search.query[axis] - node.position[axis];
+
+        // the near side always needs searching, the far side only if the sphere crosses the split
+        bool searchFar = offset * offset <= search.radiusSquared;
+        size_t nearBegin = offset < 0.0f ? begin : middle + 1;
+        size_t nearEnd = offset < 0.0f ? middle : end;
+
+        if ( !searchFar ) { begin = nearBegin; end = nearEnd; continue; }
+
+        SearchRadius ( nearBegin, nearEnd, search );
+
+        if ( offset < 0.0f ) { begin = middle + 1; }
+        else { end = middle; }
+    }
+}
+
+bool Utilities::PointKDTree::RayNearest ( const glm::vec3& origin, const glm::vec3& direction, float maxLength, float baseRadius, float radiusPerLength, Result& result ) const
+{
+    if ( mNodes.empty ( ) || maxLength <= 0.0f ) { return false; }
+
+    RaySearch search { { origin.x, origin.y, origin.z }, { direction.x, direction.y, direction.z }, maxLength, baseRadius, radiusPerLength, &result, false };
+    result.distance = std::numeric_limits<float>::max ( );
+
+    SearchRay ( 0, mNodes.size ( ), mBounds, search );
+
+    if ( search.found ) { result.distance = std::sqrt ( result.distance ); }
+    return search.found;
+}
+
+void Utilities::PointKDTree::SearchRay ( size_t begin, size_t end, Box box, RaySearch& search ) const
+{
+    while ( begin < end )
+    {
+        if ( !RayReachesBox ( box, search ) ) { return; }
+
+        size_t middle = begin + (end - begin) / 2;
+        const Node& node = mNodes[middle];
+
+        float offset[3] = { node.position[0] - search.origin[0], node.position[1] - search.origin[1], node.position[2] - search.origin[2] };
+        float along = offset[0] * search.direction[0] + offset[1] * search.direction[1] + offset[2] * search.direction[2];
+        if ( along >= 0.0f && along <= search.maxLength )
+        {
+            float perpendicularSquared = std::max ( 0.0f, offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2] - along * along );
+            float coneRadius = search.baseRadius + search.radiusPerLength * along;
+            if ( perpendicularSquared <= coneRadius * coneRadius && perpendicularSquared < search.result->distance )
+            {
+                *search.result = { node.payload, perpendicularSquared };
+                search.found = true;
+            }
+        }
+
+        // visit the side the ray starts in first, it is the more likely to tighten the search
+        int axis = mSplitAxes[middle];
+        float split = node.position[axis];
+        Box lower = box; lower.maximum[axis] = split;
+        Box upper = box; upper.minimum[axis] = split;
+
+        if ( search.origin[axis] < split )
+        {
+            SearchRay ( begin, middle, lower, search );
+            begin = middle + 1; box = upper;
+        }
+        else
+        {
+            SearchRay ( middle + 1, end, upper, search );
+            end = middle; box = lower;
+        }
+    }
+}
+
+bool Utilities::PointKDTree::RayReachesBox ( const Box& box, const RaySearch& search )
+{
+    // slab test against the box grown by the widest the cone could be inside it, also capped by the best distance so far
+    float bestDistance = search.found ? std::sqrt ( search.result->distance ) : std::numeric_limits<float>::max ( );
+    float reach = std::min ( bestDistance, search.baseRadius + search.radiusPerLength * search.maxLength );
+
+    for ( int pass = 0; pass < 2; pass++ )
+    {
+        float entry = 0.0f;
+        float exit = search.maxLength;
+
+        for ( int axis = 0; axis < 3; axis++ )
+        {
+            float minimum = box.minimum[axis] - reach;
+            float maximum = box.maximum[axis] + reach;
+
+            if ( search.direction[axis] == 0.0f )
+            {
+                if ( search.origin[axis] < minimum || search.origin[axis] > maximum ) { return false; }
+                continue;
+            }
+
+            float inverse = 1.0f / search.direction[axis];
+            float near = (minimum - search.origin[axis]) * inverse;
+            float far = (maximum - search.origin[axis]) * inverse;
+            if ( near > far ) { std::swap ( near, far ); }
+
+            entry = std::max ( entry, near );
+            exit = std::min ( exit, far );
+            if ( entry > exit ) { return false; }
+        }
+
+        // the cone is no wider than it is where the ray leaves the box, so test again with that tighter reach
+        float exitReach = std::min ( bestDistance, search.baseRadius + search.radiusPerLength * exit );
+        if ( exitReach >= reach ) { return true; }
+        reach = exitReach;
+    }
+
+    return true;
+}
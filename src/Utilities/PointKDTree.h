@@ -0,0 +1,208 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Utilities/PointRegions.h"
+#include "Utilities/PointSelection.h"
+
+#include <glm/vec3.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Acorex {
+namespace Utilities {
+
+// static kd-tree over 2D/3D points with float coordinates and integer payloads
+// nodes are stored in an implicit array layout, the subtree over [begin, end) has its root at the middle, so there are no child pointers
+// queries never allocate, results are written to a buffer supplied by the caller
+// 2D points are stored with z left at 0, and queried the same way
+class PointKDTree {
+public:
+    struct Result {
+        uint32_t payload;
+        float distance;
+    };
+
+    PointKDTree ( ) { }
+    ~PointKDTree ( ) { }
+
+    void Build ( const std::vector<glm::vec3>& points, const std::vector<uint32_t>& payloads );
+    void Clear ( );
+
+    size_t Size ( ) const { return mNodes.size ( ); }
+    bool Empty ( ) const { return mNodes.empty ( ); }
+
+    // returns how many results were written, sorted nearest first, maxDistance <= 0 searches without a limit
+    size_t KNearest ( const glm::vec3& query, size_t k, float maxDistance, Result* results ) const;
+    // returns how many results were written, in no particular order, the search stops once maxResults are found
+    size_t Radius ( const glm::vec3& query, float radius, Result* results, size_t maxResults ) const;
+    // the point closest to a ray, out of those inside a cone around it whose radius grows linearly along the ray
+    // result distance is measured perpendicular to the ray, points behind the origin or beyond maxLength are ignored, direction must be normalised
+    bool RayNearest ( const glm::vec3& origin, const glm::vec3& direction, float maxLength, float baseRadius, float radiusPerLength, Result& result ) const;
+
+    // the nearest point that accept ( payload, distance ) returns true for, maxDistance <= 0 searches without a limit
+    // accept is only asked about points closer than the best accepted so far, so rejections cost no more than the points they hide
+    using AcceptFunction = bool (*) ( uint32_t payload, float distance, void* context );
+    bool NearestMatching ( const glm::vec3& query, float maxDistance, AcceptFunction accept, void* context, Result& result ) const;
+    template <typename Accept>
+    bool NearestMatching ( const glm::vec3& query, float maxDistance, Accept& accept, Result& result ) const
+    {
+        return NearestMatching ( query, maxDistance,
+                                 [] ( uint32_t payload, float distance, void* context ) { return ( *static_cast<Accept*> ( context ) ) ( payload, distance ); },
+                                 &accept, result );
+    }
+
+    // NearestMatching for up to kMaxBatch queries in one walk of the tree, a node is visited once for every query still in reach of it and its distances are evaluated across the whole batch together
+    // the more coherent the batch (queries near each other) the more visits are shared, found[i] says whether results[i] was written
+    static constexpr size_t kMaxBatch = 64;
+    using BatchAcceptFunction = bool (*) ( size_t query, uint32_t payload, float distance, void* context );
+    void NearestMatchingBatch ( const glm::vec3* queries, const float* maxDistances, size_t count, BatchAcceptFunction accept, void* context, Result* results, bool* found ) const;
+    template <typename Accept>
+    void NearestMatchingBatch ( const glm::vec3* queries, const float* maxDistances, size_t count, Accept& accept, Result* results, bool* found ) const
+    {
+        NearestMatchingBatch ( queries, maxDistances, count,
+                               [] ( size_t query, uint32_t payload, float distance, void* context ) { return ( *static_cast<Accept*> ( context ) ) ( query, payload, distance ); },
+                               &accept, results, found );
+    }
+
+    // marks every point inside region in selection (which must cover every payload), returns how many were inside
+    // subtrees wholly inside the region are taken without testing their points, so the cost follows the region's boundary more than its contents
+    template <typename Region>
+    size_t Select ( const Region& region, PointSelection& selection ) const
+    {
+        return SelectRange ( 0, mNodes.size ( ), mBounds, region, selection );
+    }
+
+private:
+    struct Node {
+        float position[3];
+        uint32_t payload;
+    };
+
+    struct KNearestSearch {
+        const float* query;
+        Result* results; // distances are squared until the search finishes
+        size_t k;
+        size_t found;
+        float limitSquared;
+    };
+
+    struct Box {
+        float minimum[3];
+        float maximum[3];
+    };
+
+    struct RaySearch {
+        float origin[3];
+        float direction[3];
+        float maxLength;
+        float baseRadius;
+        float radiusPerLength;
+        Result* result; // distance is squared until the search finishes
+        bool found;
+    };
+
+    struct MatchingSearch {
+        const float* query;
+        AcceptFunction accept;
+        void* context;
+        Result* result; // distance is squared until the search finishes
+        bool found;
+        float limitSquared;
+    };
+
+    struct BatchSearch {
+        // structure of arrays, so distances to every query vectorise
+        float position[3][kMaxBatch];
+        float limitSquared[kMaxBatch];
+        size_t count;
+        BatchAcceptFunction accept;
+        void* context;
+        Result* results; // distances are squared until the search finishes
+        bool* found;
+    };
+
+    struct RadiusSearch {
+        const float* query;
+        Result* results;
+        size_t maxResults;
+        size_t found;
+        float radiusSquared;
+    };
+
+    void BuildRange ( size_t begin, size_t end );
+    void SearchKNearest ( size_t begin, size_t end, KNearestSearch& search ) const;
+    void SearchRadius ( size_t begin, size_t end, RadiusSearch& search ) const;
+    void SearchMatching ( size_t begin, size_t end, MatchingSearch& search ) const;
+    void SearchMatchingBatch ( size_t begin, size_t end, uint64_t active, BatchSearch& search ) const; // active has a bit set for each query still searching this subtree
+    uint64_t InReach ( uint64_t queries, const Node& node, int axis, const BatchSearch& search ) const; // those of queries whose limit crosses the node's split
+    void SearchRay ( size_t begin, size_t end, Box box, RaySearch& search ) const;
+
+    template <typename Region>
+    size_t SelectRange ( size_t begin, size_t end, Box box, const Region& region, PointSelection& selection ) const
+    {
+        size_t selected = 0;
+        while ( begin < end )
+        {
+            RegionOverlap overlap = region.Classify ( box.minimum, box.maximum );
+            if ( overlap == RegionOverlap::Outside ) { break; }
+            if ( overlap == RegionOverlap::Inside )
+            {
+                for ( size_t i = begin; i < end; i++ ) { selection.Set ( mNodes[i].payload ); }
+                selected += end - begin;
+                break;
+            }
+
+            size_t middle = begin + (end - begin) / 2;
+            const Node& node = mNodes[middle];
+            if ( region.Contains ( node.position ) ) { selection.Set ( node.payload ); selected++; }
+
+            int axis = mSplitAxes[middle];
+            Box lower = box; lower.maximum[axis] = node.position[axis];
+            Box upper = box; upper.minimum[axis] = node.position[axis];
+
+            selected += SelectRange ( begin, middle, lower, region, selection );
+            begin = middle + 1; box = upper;
+        }
+        return selected;
+    }
+    static bool RayReachesBox ( const Box& box, const RaySearch& search );
+
+    static size_t BitCount ( uint64_t bits )
+    {
+        size_t count = 0;
+        for ( ; bits != 0; bits &= bits - 1 ) { count++; }
+        return count;
+    }
+
+    static float DistanceSquared ( const Node& node, const float* query )
+    {
+        float dx = node.position[0] - query[0];
+        float dy = node.position[1] - query[1];
+        float dz = node.position[2] - query[2];
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    std::vector<Node> mNodes;
+    std::vector<uint8_t> mSplitAxes; // per node, the axis its subtree is split on
+    Box mBounds; // subtree bounds are derived from this while traversing by cutting at each split
+};
+
+} // namespace Utilities
+} // namespace Acorex
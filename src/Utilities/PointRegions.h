@@ -0,0 +1,157 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/common.hpp>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace Acorex {
+namespace Utilities {
+
+// regions for PointKDTree::Select, each says how a box of the tree's space overlaps it and whether a single point is inside
+// a box entirely inside is taken whole, so Classify only needs to be exact about Outside and Inside, anything unsure can be Partial
+
+enum class RegionOverlap { Outside, Partial, Inside };
+
+struct BoxRegion {
+    glm::vec3 minimum;
+    glm::vec3 maximum;
+
+    RegionOverlap Classify ( const float* low, const float* high ) const
+    {
+        bool inside = true;
+        for ( int axis = 0; axis < 3; axis++ )
+        {
+            if ( high[axis] < minimum[axis] || low[axis] > maximum[axis] ) { return RegionOverlap::Outside; }
+            if ( low[axis] < minimum[axis] || high[axis] > maximum[axis] ) { inside = false; }
+        }
+        return inside ? RegionOverlap::Inside : RegionOverlap::Partial;
+    }
+
+    bool Contains ( const float* position ) const
+    {
+        for ( int axis = 0; axis < 3; axis++ )
+        {
+            if ( position[axis] < minimum[axis] || position[axis] > maximum[axis] ) { return false; }
+        }
+        return true;
+    }
+};
+
+struct SphereRegion {
+    glm::vec3 centre;
+    float radius;
+
+    RegionOverlap Classify ( const float* low, const float* high ) const
+    {
+        float nearestSquared = 0.0f;
+        float farthestSquared = 0.0f;
+        for ( int axis = 0; axis < 3; axis++ )
+        {
+            float below = low[axis] - centre[axis];
+            float above = centre[axis] - high[axis];
+            float nearest = std::max ( 0.0f, std::max ( below, above ) );
+            float farthest = std::max ( std::abs ( below ), std::abs ( above ) );
+            nearestSquared += nearest * nearest;
+            farthestSquared += farthest * farthest;
+        }
+
+        if ( nearestSquared > radius * radius ) { return RegionOverlap::Outside; }
+        return farthestSquared <= radius * radius ? RegionOverlap::Inside : RegionOverlap::Partial;
+    }
+
+    bool Contains ( const float* position ) const
+    {
+        float dx = position[0] - centre[0];
+        float dy = position[1] - centre[1];
+        float dz = position[2] - centre[2];
+        return dx * dx + dy * dy + dz * dz <= radius * radius;
+    }
+};
+
+// points as they appear on screen, through every depth the camera sees
+// selects the rectangle low..high, or when polygon is given (a lasso, any shape, edges may cross) the part of it inside that rectangle
+struct ScreenRegion {
+    glm::mat4 toClip; // the tree's space to clip space
+    glm::vec4 viewport; // x, y, width, height, in pixels
+    glm::vec2 low; // pixels, y down as the mouse reports it
+    glm::vec2 high;
+    std::vector<glm::vec2> polygon;
+
+    bool Project ( const float* position, glm::vec2& screen ) const // false if behind the camera
+    {
+        glm::vec4 clip = toClip * glm::vec4 ( position[0], position[1], position[2], 1.0f );
+        if ( clip.w <= 0.0f ) { return false; }
+
+        screen.x = viewport.x + ( clip.x / clip.w + 1.0f ) * 0.5f * viewport.z;
+        screen.y = viewport.y + ( 1.0f - clip.y / clip.w ) * 0.5f * viewport.w;
+        return true;
+    }
+
+    RegionOverlap Classify ( const float* low, const float* high ) const
+    {
+        // a box projects inside the hull of its projected corners, unless some are behind the camera
+        glm::vec2 cornersLow ( std::numeric_limits<float>::max ( ) );
+        glm::vec2 cornersHigh ( std::numeric_limits<float>::lowest ( ) );
+        int behind = 0;
+        for ( int corner = 0; corner < 8; corner++ )
+        {
+            float position[3] = { corner & 1 ? high[0] : low[0], corner & 2 ? high[1] : low[1], corner & 4 ? high[2] : low[2] };
+            glm::vec2 screen;
+            if ( !Project ( position, screen ) ) { behind++; continue; }
+            cornersLow = glm::min ( cornersLow, screen );
+            cornersHigh = glm::max ( cornersHigh, screen );
+        }
+
+        if ( behind == 8 ) { return RegionOverlap::Outside; }
+        if ( behind > 0 ) { return RegionOverlap::Partial; }
+
+        if ( cornersHigh.x < this->low.x || cornersLow.x > this->high.x || cornersHigh.y < this->low.y || cornersLow.y > this->high.y ) { return RegionOverlap::Outside; }
+
+        bool insideRectangle = cornersLow.x >= this->low.x && cornersHigh.x <= this->high.x && cornersLow.y >= this->low.y && cornersHigh.y <= this->high.y;
+        return insideRectangle && polygon.empty ( ) ? RegionOverlap::Inside : RegionOverlap::Partial;
+    }
+
+    bool Contains ( const float* position ) const
+    {
+        glm::vec2 screen;
+        if ( !Project ( position, screen ) ) { return false; }
+        if ( screen.x < low.x || screen.x > high.x || screen.y < low.y || screen.y > high.y ) { return false; }
+        if ( polygon.empty ( ) ) { return true; }
+
+        // even-odd rule, counting the edges a horizontal line from the point crosses
+        bool inside = false;
+        for ( size_t i = 0, j = polygon.size ( ) - 1; i < polygon.size ( ); j = i++ )
+        {
+            const glm::vec2& a = polygon[i];
+            const glm::vec2& b = polygon[j];
+            if ( ( a.y > screen.y ) != ( b.y > screen.y ) && screen.x < ( b.x - a.x ) * ( screen.y - a.y ) / ( b.y - a.y ) + a.x ) { inside = !inside; }
+        }
+        return inside;
+    }
+};
+
+} // namespace Utilities
+} // namespace Acorex
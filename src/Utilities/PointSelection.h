@@ -0,0 +1,115 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#if defined ( _MSC_VER )
+#include <intrin.h>
+#endif
+
+namespace Acorex {
+namespace Utilities {
+
+// index of the lowest set bit, bits must not be 0
+inline size_t LowestBit ( uint64_t bits )
+{
+#if defined ( _MSC_VER )
+    unsigned long index;
+    _BitScanForward64 ( &index, bits );
+    return index;
+#else
+    return (size_t)__builtin_ctzll ( bits );
+#endif
+}
+
+// a set of corpus points, one bit per point, numbered as the search index numbers them (each file's points in order, files one after another)
+// cheap to copy and combine, so other parts of the explorer can hold their own
+class PointSelection {
+public:
+    PointSelection ( ) { }
+    explicit PointSelection ( size_t points ) { Resize ( points ); }
+    ~PointSelection ( ) { }
+
+    void Resize ( size_t points ) // anything selected is cleared
+    {
+        mPoints = points;
+        mWords.assign ( ( points + 63 ) / 64, 0 );
+    }
+
+    void Clear ( ) { std::fill ( mWords.begin ( ), mWords.end ( ), 0 ); }
+
+    size_t Size ( ) const { return mPoints; }
+
+    void Set ( uint32_t point ) { mWords[point >> 6] |= (uint64_t)1 << ( point & 63 ); }
+    void Reset ( uint32_t point ) { mWords[point >> 6] &= ~( (uint64_t)1 << ( point & 63 ) ); }
+    bool Test ( uint32_t point ) const { return point < mPoints && ( mWords[point >> 6] >> ( point & 63 ) ) & 1; }
+
+    size_t Count ( ) const
+    {
+        size_t count = 0;
+        for ( uint64_t word : mWords ) { for ( ; word != 0; word &= word - 1 ) { count++; } }
+        return count;
+    }
+
+    bool Empty ( ) const
+    {
+        for ( uint64_t word : mWords ) { if ( word != 0 ) { return false; } }
+        return true;
+    }
+
+    // combining selections of different sizes treats the points past the smaller one as unselected
+    void Union ( const PointSelection& other )
+    {
+        for ( size_t i = 0; i < std::min ( mWords.size ( ), other.mWords.size ( ) ); i++ ) { mWords[i] |= other.mWords[i]; }
+    }
+
+    void Intersect ( const PointSelection& other )
+    {
+        for ( size_t i = 0; i < mWords.size ( ); i++ ) { mWords[i] &= i < other.mWords.size ( ) ? other.mWords[i] : 0; }
+    }
+
+    void Subtract ( const PointSelection& other )
+    {
+        for ( size_t i = 0; i < std::min ( mWords.size ( ), other.mWords.size ( ) ); i++ ) { mWords[i] &= ~other.mWords[i]; }
+    }
+
+    // calls function ( point ) for each selected point in ascending order
+    template <typename Function>
+    void ForEach ( Function&& function ) const
+    {
+        for ( size_t i = 0; i < mWords.size ( ); i++ )
+        {
+            for ( uint64_t word = mWords[i]; word != 0; word &= word - 1 )
+            {
+                function ( (uint32_t)( i * 64 + LowestBit ( word ) ) );
+            }
+        }
+    }
+
+    const std::vector<uint64_t>& GetWords ( ) const { return mWords; }
+
+private:
+    std::vector<uint64_t> mWords;
+    size_t mPoints = 0;
+};
+
+} // namespace Utilities
+} // namespace Acorex
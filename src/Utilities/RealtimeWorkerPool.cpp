@@ -0,0 +1,186 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Utilities/RealtimeWorkerPool.h"
+#include "Utilities/NoAllocationScope.h"
+#include "Utilities/TemporaryDefaults.h"
+
+#include <chrono>
+#include <algorithm>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+using namespace Acorex;
+
+Utilities::RealtimeWorkerPool::RealtimeWorkerPool ( )
+    : mClaims ( 0 ), mJobsDone ( 0 ), mInvoke ( nullptr ), mJob ( nullptr ), mGeneration ( 0 ), bRunning ( false ), mParkedWorkers ( 0 )
+{
+}
+
+void Utilities::RealtimeWorkerPool::Start ( size_t workers )
+{
+    Stop ( );
+
+    if ( workers == 0 ) { return; }
+
+    bRunning = true;
+
+    size_t cores = std::max ( std::thread::hardware_concurrency ( ), 1u );
+    mWorkers.reserve ( workers );
+    for ( size_t workerIndex = 1; workerIndex <= workers; workerIndex++ )
+    {
+        mWorkers.emplace_back ( &RealtimeWorkerPool::WorkerLoop, this, workerIndex );
+        PinToCore ( mWorkers.back ( ), workerIndex % cores ); // core 0 is left to the rest of the system where there are enough
+    }
+}
+
+void Utilities::RealtimeWorkerPool::Stop ( )
+{
+    if ( mWorkers.empty ( ) ) { return; }
+
+    {
+        std::lock_guard<std::mutex> lock ( mParkMutex );
+        bRunning = false;
+    }
+    mParkCondition.notify_all ( );
+
+    for ( auto& worker : mWorkers ) { worker.join ( ); }
+    mWorkers.clear ( );
+}
+
+void Utilities::RealtimeWorkerPool::Dispatch ( InvokeFunction invoke, void* job, size_t jobCount )
+{
+    // the last batch has finished, so nothing can still be reading these
+    mJobsDone.store ( 0, std::memory_order_relaxed );
+    mInvoke.store ( invoke, std::memory_order_relaxed );
+    mJob.store ( job, std::memory_order_relaxed );
+
+    mGeneration++;
+    mClaims.store ( ( (uint64_t)mGeneration << 32 ) | ( (uint64_t)jobCount << 16 ), std::memory_order_release );
+
+    // a wakeup lost to a worker that was just parking only means one less helper for this batch
+    if ( mParkedWorkers.load ( std::memory_order_acquire ) > 0 ) { mParkCondition.notify_all ( ); }
+
+    while ( RunNextJob ( mGeneration, 0 ) ) { }
+
+    // whatever is left is already running on a worker
+    while ( mJobsDone.load ( std::memory_order_acquire ) < jobCount ) { CpuRelax ( ); }
+}
+
+bool Utilities::RealtimeWorkerPool::RunNextJob ( uint32_t generation, size_t workerIndex )
+{
+    uint64_t claims = mClaims.load ( std::memory_order_acquire );
+    while ( true )
+    {
+        size_t jobCount = ( claims >> 16 ) & kMaxJobs;
+        size_t jobIndex = claims & kMaxJobs;
+        if ( (uint32_t)( claims >> 32 ) != generation || jobIndex >= jobCount ) { return false; }
+
+        // read before claiming, if this batch ends and another begins in between then the claim fails and these are read again
+        InvokeFunction invoke = mInvoke.load ( std::memory_order_relaxed );
+        void* job = mJob.load ( std::memory_order_relaxed );
+
+        if ( mClaims.compare_exchange_weak ( claims, claims + 1, std::memory_order_acq_rel, std::memory_order_acquire ) )
+        {
+            invoke ( job, jobIndex, workerIndex );
+            mJobsDone.fetch_add ( 1, std::memory_order_release );
+            return true;
+        }
+    }
+}
+
+void Utilities::RealtimeWorkerPool::WorkerLoop ( size_t workerIndex )
+{
+    uint32_t seenGeneration = (uint32_t)( mClaims.load ( std::memory_order_acquire ) >> 32 );
+    size_t spins = 0;
+    auto idleSince = std::chrono::steady_clock::now ( );
+
+    while ( bRunning )
+    {
+        uint32_t generation = (uint32_t)( mClaims.load ( std::memory_order_acquire ) >> 32 );
+        if ( generation != seenGeneration )
+        {
+            seenGeneration = generation;
+            {
+                NoAllocationScope noAllocationScope;
+                while ( RunNextJob ( generation, workerIndex ) ) { }
+            }
+            spins = 0;
+            idleSince = std::chrono::steady_clock::now ( );
+            continue;
+        }
+
+        if ( spins < DEFAULT_REALTIME_WORKER_SPINS )
+        {
+            spins++;
+            CpuRelax ( );
+            continue;
+        }
+
+        if ( std::chrono::steady_clock::now ( ) - idleSince < std::chrono::milliseconds ( DEFAULT_REALTIME_WORKER_PARK_AFTER_MS ) )
+        {
+            std::this_thread::yield ( );
+            continue;
+        }
+
+        // nothing for a while, the audio has probably stopped, the timeout covers a wakeup missed while parking
+        mParkedWorkers.fetch_add ( 1, std::memory_order_acq_rel );
+        {
+            std::unique_lock<std::mutex> lock ( mParkMutex );
+            mParkCondition.wait_for ( lock, std::chrono::milliseconds ( DEFAULT_REALTIME_WORKER_PARK_AFTER_MS ), [&] ( )
+                { return !bRunning || (uint32_t)( mClaims.load ( std::memory_order_acquire ) >> 32 ) != seenGeneration; } );
+        }
+        mParkedWorkers.fetch_sub ( 1, std::memory_order_acq_rel );
+        spins = 0;
+        idleSince = std::chrono::steady_clock::now ( );
+    }
+}
+
+void Utilities::RealtimeWorkerPool::PinToCore ( std::thread& thread, size_t core )
+{
+#if defined(_WIN32)
+    SetThreadAffinityMask ( thread.native_handle ( ), (DWORD_PTR)1 << core );
+#elif defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO ( &cpuSet );
+    CPU_SET ( core, &cpuSet );
+    pthread_setaffinity_np ( thread.native_handle ( ), sizeof ( cpu_set_t ), &cpuSet );
+#else
+    (void)thread; (void)core; // no affinity to set on macOS, the scheduler keeps busy threads where they are well enough
+#endif
+}
+
+void Utilities::RealtimeWorkerPool::CpuRelax ( )
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause ( );
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__ ( "yield" );
+#endif
+}
@@ -0,0 +1,94 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+
+namespace Acorex {
+namespace Utilities {
+
+// a fixed set of threads, each pinned to its own core, that help the calling thread through a batch of jobs and then wait for the next
+// handing a batch over and taking jobs from it is lock-free, so the calling thread can be the audio thread
+// workers spin, then yield, between batches, and only park after a long idle, a parked worker is woken without the caller taking a lock
+class RealtimeWorkerPool {
+public:
+    RealtimeWorkerPool ( );
+    ~RealtimeWorkerPool ( ) { Stop ( ); }
+
+    RealtimeWorkerPool ( const RealtimeWorkerPool& ) = delete;
+    RealtimeWorkerPool& operator= ( const RealtimeWorkerPool& ) = delete;
+
+    void Start ( size_t workers ); // stops any running workers first, Run must not be in progress
+    void Stop ( );
+
+    size_t GetWorkerCount ( ) const { return mWorkers.size ( ); }
+
+    // calls job ( jobIndex, workerIndex ) once for every jobIndex below jobCount, and returns once they have all finished
+    // workerIndex is 0 on the calling thread and 1 up to GetWorkerCount on the pool's, so jobs can keep scratch per worker
+    // the calling thread takes jobs as well, one at a time like the workers, so a batch never waits on a worker that hasn't woken
+    template <typename Job>
+    void Run ( size_t jobCount, Job& job )
+    {
+        if ( mWorkers.empty ( ) || jobCount == 1 || jobCount > kMaxJobs )
+        {
+            for ( size_t jobIndex = 0; jobIndex < jobCount; jobIndex++ ) { job ( jobIndex, 0 ); }
+            return;
+        }
+
+        if ( jobCount > 0 ) { Dispatch ( &Invoke<Job>, &job, jobCount ); }
+    }
+
+private:
+    using InvokeFunction = void (*) ( void* job, size_t jobIndex, size_t workerIndex );
+
+    template <typename Job>
+    static void Invoke ( void* job, size_t jobIndex, size_t workerIndex ) { ( *static_cast<Job*> ( job ) ) ( jobIndex, workerIndex ); }
+
+    void Dispatch ( InvokeFunction invoke, void* job, size_t jobCount );
+    bool RunNextJob ( uint32_t generation, size_t workerIndex ); // false once every job of this batch has been taken
+    void WorkerLoop ( size_t workerIndex );
+
+    static void PinToCore ( std::thread& thread, size_t core );
+    static void CpuRelax ( );
+
+    // the batch's generation, job count and next job share one word, so a worker that wakes late can never take a job from the batch after
+    // [ generation : 32 | job count : 16 | next job : 16 ]
+    static constexpr size_t kMaxJobs = 0xFFFF;
+
+    alignas ( 64 ) std::atomic<uint64_t> mClaims;
+    alignas ( 64 ) std::atomic<size_t> mJobsDone;
+    std::atomic<InvokeFunction> mInvoke;
+    std::atomic<void*> mJob;
+    uint32_t mGeneration; // calling thread only
+
+    std::vector<std::thread> mWorkers;
+    std::atomic<bool> bRunning;
+
+    std::atomic<size_t> mParkedWorkers;
+    std::mutex mParkMutex; // taken by workers only
+    std::condition_variable mParkCondition;
+};
+
+} // namespace Utilities
+} // namespace Acorex
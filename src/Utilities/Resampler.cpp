@@ -0,0 +1,286 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Utilities/Resampler.h"
+
+#include <ofSoundBuffer.h>
+#include <ofLog.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace Acorex;
+
+static double BesselI0 ( double x )
+{
+    double sum = 1.0, term = 1.0;
+    for ( int k = 1; k < 32; k++ )
+    {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if ( term < sum * 1e-12 ) { break; }
+    }
+    return sum;
+}
+
+Utilities::Resampler::Resampler ( )
+    : bPassthrough ( true ), mSourceRate ( 0.0 ), mTargetRate ( 0.0 ), mStep ( 1.0 ),
+    mTaps ( 0 ), mHalfTaps ( 0 ), mPosition ( 0.0 )
+{
+}
+
+void Utilities::Resampler::Initialise ( double sourceRate, double targetRate )
+{
+    if ( sourceRate != mSourceRate || targetRate != mTargetRate )
+    {
+        mSourceRate = sourceRate;
+        mTargetRate = targetRate;
+        mStep = sourceRate / targetRate;
+        bPassthrough = sourceRate == targetRate;
+
+        if ( bPassthrough )
+        {
+            mTaps = 0; mHalfTaps = 0;
+            mFilterBank.clear ( ); mFilterDeltas.clear ( );
+        }
+        else
+        {
+            BuildFilterBank ( );
+        }
+    }
+
+    Reset ( );
+}
+
+void Utilities::Resampler::BuildFilterBank ( )
+{
+    // cutoff just below the lower of the two nyquist frequencies, as a fraction of the source nyquist
+    double cutoff = std::min ( 1.0, 1.0 / mStep ) * 0.95;
+    double beta = 9.0;
+    double windowNormalise = 1.0 / BesselI0 ( beta );
+
+    mHalfTaps = (size_t)std::ceil ( kZeroCrossings / cutoff );
+    mTaps = mHalfTaps * 2;
+
+    mFilterBank.assign ( (kPhases + 1) * mTaps, 0.0f );
+    mFilterDeltas.assign ( (kPhases + 1) * mTaps, 0.0f );
+
+    for ( size_t phase = 0; phase <= kPhases; phase++ )
+    {
+        double fraction = (double)phase / (double)kPhases;
+        double rowSum = 0.0;
+        std::vector<double> row ( mTaps );
+
+        for ( size_t tap = 0; tap < mTaps; tap++ )
+        {
+            double distance = (double)tap - (double)mHalfTaps + 1.0 - fraction; // in source frames from the output position
+            double x = cutoff * distance;
+            double sinc = std::abs ( x ) < 1e-9 ? 1.0 : std::sin ( M_PI * x ) / (M_PI * x);
+
+            double windowPosition = distance / (double)mHalfTaps;
+            double window = std::abs ( windowPosition ) >= 1.0 ? 0.0 : BesselI0 ( beta * std::sqrt ( 1.0 - windowPosition * windowPosition ) ) * windowNormalise;
+
+            row[tap] = cutoff * sinc * window;
+            rowSum += row[tap];
+        }
+
+        for ( size_t tap = 0; tap < mTaps; tap++ )
+        {
+            mFilterBank[phase * mTaps + tap] = (float)(row[tap] / rowSum); // unity gain at DC for every phase
+        }
+    }
+
+    for ( size_t phase = 0; phase < kPhases; phase++ )
+    {
+        for ( size_t tap = 0; tap < mTaps; tap++ )
+        {
+            mFilterDeltas[phase * mTaps + tap] = mFilterBank[(phase + 1) * mTaps + tap] - mFilterBank[phase * mTaps + tap];
+        }
+    }
+}
+
+void Utilities::Resampler::Reset ( double startPosition )
+{
+    // silence before the first frame, so the first outputs have a full filter window
+    size_t history = mHalfTaps > 0 ? mHalfTaps - 1 : 0;
+    mInput.assign ( history, 0.0f );
+    mPosition = (double)history + startPosition;
+}
+
+void Utilities::Resampler::Process ( const std::vector<float>& input, std::vector<float>& output )
+{
+    if ( bPassthrough )
+    {
+        output = input;
+        return;
+    }
+
+    Reset ( );
+    mInput.reserve ( mInput.size ( ) + input.size ( ) + mHalfTaps );
+
+    output.resize ( GetMaxOutputFrames ( input.size ( ) ) + GetMaxOutputFrames ( mHalfTaps ) );
+    size_t produced = ProcessChunk ( input.data ( ), input.size ( ), output.data ( ) );
+    produced += Flush ( output.data ( ) + produced );
+
+    size_t expected = (size_t)( (double)input.size ( ) * mTargetRate / mSourceRate );
+    output.resize ( expected, 0.0f );
+
+    Reset ( );
+    std::vector<float> ( ).swap ( mInput ); // don't hold on to a whole file worth of history
+}
+
+void Utilities::Resampler::Process ( std::vector<float>& audio )
+{
+    if ( bPassthrough ) { return; }
+
+    std::vector<float> output;
+    Process ( audio, output );
+    audio.swap ( output );
+}
+
+void Utilities::Resampler::Reserve ( size_t maxChunkFrames )
+{
+    // what Render leaves behind is never more than a filter's worth of history, plus a frame of position
+    mInput.reserve ( mTaps + 1 + maxChunkFrames );
+}
+
+size_t Utilities::Resampler::ProcessChunk ( const float* input, size_t inputFrames, float* output )
+{
+    if ( bPassthrough )
+    {
+        std::copy ( input, input + inputFrames, output );
+        return inputFrames;
+    }
+
+    mInput.insert ( mInput.end ( ), input, input + inputFrames );
+    return Render ( output );
+}
+
+size_t Utilities::Resampler::Flush ( float* output )
+{
+    if ( bPassthrough ) { return 0; }
+
+    mInput.insert ( mInput.end ( ), mHalfTaps + 1, 0.0f );
+    return Render ( output );
+}
+
+size_t Utilities::Resampler::GetMaxOutputFrames ( size_t inputFrames ) const
+{
+    if ( bPassthrough ) { return inputFrames; }
+
+    return (size_t)std::ceil ( (double)(inputFrames + mTaps) / mStep ) + 1;
+}
+
+size_t Utilities::Resampler::Render ( float* output )
+{
+    size_t produced = 0;
+    size_t taps = mTaps;
+
+    while ( true )
+    {
+        size_t index = (size_t)mPosition;
+        if ( index + mHalfTaps >= mInput.size ( ) ) { break; }
+
+        double phasePosition = (mPosition - (double)index) * (double)kPhases;
+        size_t phase = (size_t)phasePosition;
+        float blend = (float)(phasePosition - (double)phase);
+
+        const float* x = mInput.data ( ) + (index + 1 - mHalfTaps);
+        const float* h = mFilterBank.data ( ) + phase * taps;
+        const float* d = mFilterDeltas.data ( ) + phase * taps;
+
+        float sum = 0.0f;
+#pragma omp simd reduction(+:sum)
+        for ( size_t tap = 0; tap < taps; tap++ )
+        {
+            sum += x[tap] * (h[tap] + blend * d[tap]);
+        }
+
+        output[produced] = sum;
+        produced++;
+        mPosition += mStep;
+    }
+
+    // drop history that no future output frame can reach
+    size_t index = (size_t)mPosition;
+    if ( index + 1 > mHalfTaps )
+    {
+        size_t discard = std::min ( index + 1 - mHalfTaps, mInput.size ( ) );
+        mInput.erase ( mInput.begin ( ), mInput.begin ( ) + discard );
+        mPosition -= (double)discard;
+    }
+
+    return produced;
+}
+
+// how corpus audio used to be resampled when loading, kept to benchmark against
+static void ResampleHermite ( std::vector<float>& audio, double fileRate, double targetRate )
+{
+    ofSoundBuffer resampleBuffer;
+
+    resampleBuffer.copyFrom ( audio, 1, fileRate );
+    resampleBuffer.resample ( (fileRate / targetRate), ofSoundBuffer::Hermite );
+    resampleBuffer.setSampleRate ( targetRate );
+
+    audio.resize ( resampleBuffer.size ( ) );
+    resampleBuffer.copyTo ( audio.data ( ), resampleBuffer.size ( ), 1, 0, false );
+}
+
+void Utilities::Resampler::Benchmark ( )
+{
+    struct BenchmarkCase { double fileRate; double targetRate; double toneFrequency; };
+    const BenchmarkCase cases[] = {
+        { 48000.0, 44100.0, 1000.0 },
+        { 96000.0, 44100.0, 5000.0 },
+        { 96000.0, 44100.0, 30000.0 }, // above the target nyquist, anything left in the output is aliasing
+        { 22050.0, 44100.0, 3000.0 },
+        { 44100.0, 44100.0, 1000.0 } };
+    const double sourceSeconds = 10.0;
+
+    for ( const BenchmarkCase& benchmarkCase : cases )
+    {
+        std::vector<float> source ( (size_t)( benchmarkCase.fileRate * sourceSeconds ) );
+        for ( size_t i = 0; i < source.size ( ); i++ )
+        {
+            source[i] = 0.5f * (float)std::sin ( 2.0 * M_PI * benchmarkCase.toneFrequency * (double)i / benchmarkCase.fileRate );
+        }
+
+        double rms[2] = { 0.0, 0.0 };
+        double seconds[2] = { 0.0, 0.0 };
+        for ( int method = 0; method < 2; method++ )
+        {
+            std::vector<float> audio = source;
+            auto start = std::chrono::steady_clock::now ( );
+            if ( method == 0 )
+            {
+                Resampler resampler;
+                resampler.Initialise ( benchmarkCase.fileRate, benchmarkCase.targetRate );
+                resampler.Process ( audio );
+            }
+            else { ResampleHermite ( audio, benchmarkCase.fileRate, benchmarkCase.targetRate ); }
+            seconds[method] = std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - start ).count ( );
+
+            double sum = 0.0;
+            for ( float sample : audio ) { sum += (double)sample * sample; }
+            rms[method] = audio.empty ( ) ? 0.0 : std::sqrt ( sum / audio.size ( ) );
+        }
+
+        ofLogNotice ( "Resampler" ) << benchmarkCase.fileRate << " -> " << benchmarkCase.targetRate << " Hz, " << benchmarkCase.toneFrequency << " Hz tone: "
+            << "polyphase " << ( sourceSeconds / std::max ( seconds[0], 1e-9 ) ) << "x realtime, rms " << rms[0] << " | "
+            << "hermite " << ( sourceSeconds / std::max ( seconds[1], 1e-9 ) ) << "x realtime, rms " << rms[1];
+    }
+}
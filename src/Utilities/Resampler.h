@@ -0,0 +1,74 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+namespace Acorex {
+namespace Utilities {
+
+// band-limited sample rate converter using a precomputed polyphase windowed-sinc filter bank
+// works either on whole buffers or as a stream fed in chunks of any size, passes audio straight through when rates match
+class Resampler {
+public:
+    Resampler ( );
+    ~Resampler ( ) { }
+
+    void Initialise ( double sourceRate, double targetRate ); // rebuilds the filter bank only if the ratio changed, then resets
+    void Reset ( double startPosition = 0.0 ); // startPosition is in source frames, relative to the first frame fed in after resetting
+
+    bool IsPassthrough ( ) const { return bPassthrough; }
+    double GetStep ( ) const { return mStep; } // source frames per output frame
+    size_t GetLatency ( ) const { return mHalfTaps; } // source frames of lookahead needed around each output frame
+
+    // whole buffer, output length is floor ( input length * target rate / source rate )
+    void Process ( const std::vector<float>& input, std::vector<float>& output );
+    void Process ( std::vector<float>& audio ); // in place
+
+    // streaming, returns frames written, never more than GetMaxOutputFrames ( inputFrames )
+    void Reserve ( size_t maxChunkFrames ); // after Initialise, chunks no bigger than this are then processed without allocating
+    size_t ProcessChunk ( const float* input, size_t inputFrames, float* output );
+    size_t Flush ( float* output ); // pushes the lookahead through after the last chunk, output needs GetMaxOutputFrames ( GetLatency ( ) ) space
+    size_t GetMaxOutputFrames ( size_t inputFrames ) const;
+
+    static void Benchmark ( ); // times this resampler against the hermite path it replaced when loading corpus audio, results go to the log
+
+private:
+    void BuildFilterBank ( );
+    size_t Render ( float* output ); // renders every output frame whose filter window is fully buffered
+
+    static constexpr size_t kPhases = 256;
+    static constexpr size_t kZeroCrossings = 16; // per side, at the cutoff frequency
+
+    bool bPassthrough;
+    double mSourceRate;
+    double mTargetRate;
+    double mStep;
+
+    size_t mTaps;
+    size_t mHalfTaps;
+    std::vector<float> mFilterBank; // [phase][tap], kPhases + 1 rows so every phase has a neighbour to interpolate towards
+    std::vector<float> mFilterDeltas; // [phase][tap], next phase minus this phase
+
+    std::vector<float> mInput; // buffered source frames, the front holds history still needed by the filter
+    double mPosition; // source position of the next output frame, relative to the front of mInput
+};
+
+} // namespace Utilities
+} // namespace Acorex
@@ -0,0 +1,103 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+namespace Acorex {
+namespace Utilities {
+
+// bounded lock-free queue for exactly one producer thread and one consumer thread
+// storage is allocated once by Reserve, before either thread uses the queue, Push and Pop never allocate or block
+template <typename T>
+class SPSCQueue {
+public:
+    SPSCQueue ( ) { }
+    explicit SPSCQueue ( size_t capacity ) { Reserve ( capacity ); }
+
+    SPSCQueue ( const SPSCQueue& ) = delete;
+    SPSCQueue& operator= ( const SPSCQueue& ) = delete;
+
+    // not thread safe, capacity is rounded up to a power of two, anything queued is discarded
+    void Reserve ( size_t capacity )
+    {
+        size_t size = 1;
+        while ( size < capacity ) { size <<= 1; }
+
+        mBuffer.assign ( size, T ( ) );
+        mMask = size - 1;
+        mHead.store ( 0, std::memory_order_relaxed );
+        mTail.store ( 0, std::memory_order_relaxed );
+    }
+
+    size_t Capacity ( ) const { return mBuffer.size ( ); }
+    // exact only on the calling side, never more than the producer has pushed or less than the consumer has left
+    size_t Size ( ) const { return mTail.load ( std::memory_order_acquire ) - mHead.load ( std::memory_order_acquire ); }
+
+    // producer only, returns false if full
+    bool Push ( const T& value )
+    {
+        size_t tail = mTail.load ( std::memory_order_relaxed );
+        if ( tail - mHead.load ( std::memory_order_acquire ) >= mBuffer.size ( ) ) { return false; }
+
+        mBuffer[tail & mMask] = value;
+        mTail.store ( tail + 1, std::memory_order_release );
+        return true;
+    }
+
+    // consumer only, returns false if empty
+    bool Pop ( T& value )
+    {
+        size_t head = mHead.load ( std::memory_order_relaxed );
+        if ( head == mTail.load ( std::memory_order_acquire ) ) { return false; }
+
+        value = mBuffer[head & mMask];
+        mHead.store ( head + 1, std::memory_order_release );
+        return true;
+    }
+
+    // consumer only, the oldest entry without removing it, nullptr if empty
+    const T* Peek ( ) const
+    {
+        size_t head = mHead.load ( std::memory_order_relaxed );
+        if ( head == mTail.load ( std::memory_order_acquire ) ) { return nullptr; }
+        return &mBuffer[head & mMask];
+    }
+
+    // consumer only, removes the entry Peek returned
+    void Drop ( )
+    {
+        size_t head = mHead.load ( std::memory_order_relaxed );
+        if ( head != mTail.load ( std::memory_order_acquire ) ) { mHead.store ( head + 1, std::memory_order_release ); }
+    }
+
+    bool Empty ( ) const { return mHead.load ( std::memory_order_acquire ) == mTail.load ( std::memory_order_acquire ); }
+
+private:
+    std::vector<T> mBuffer;
+    size_t mMask = 0;
+
+    // kept on separate cache lines, each is written by only one side
+    alignas ( 64 ) std::atomic<size_t> mHead { 0 }; // next to pop, written by the consumer
+    alignas ( 64 ) std::atomic<size_t> mTail { 0 }; // next to push, written by the producer
+};
+
+} // namespace Utilities
+} // namespace Acorex
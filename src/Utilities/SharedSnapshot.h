@@ -0,0 +1,145 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+namespace Acorex {
+namespace Utilities {
+
+// an immutable object published to any number of reader threads through an atomically swapped pointer
+// readers never block or allocate, a replaced object is only deleted once no reader that could have seen it is still reading (epoch based reclamation)
+// publishing and reclaiming happen on writer threads only, so deletion never lands on a reader (e.g. the audio thread)
+template <typename T>
+class SharedSnapshot {
+public:
+    // holds the snapshot that was current when it was created for as long as it lives, Get returns nullptr if nothing is published
+    class ReadGuard {
+    public:
+        ReadGuard ( ReadGuard&& other ) noexcept : mOwner ( other.mOwner ), mSlot ( other.mSlot ), mValue ( other.mValue ) { other.mOwner = nullptr; }
+        ReadGuard ( const ReadGuard& ) = delete;
+        ReadGuard& operator= ( const ReadGuard& ) = delete;
+        ~ReadGuard ( ) { if ( mOwner != nullptr && mSlot >= 0 ) { mOwner->mReaderEpochs[mSlot].store ( 0, std::memory_order_release ); } }
+
+        const T* Get ( ) const { return mValue; }
+        const T* operator-> ( ) const { return mValue; }
+        const T& operator* ( ) const { return *mValue; }
+        explicit operator bool ( ) const { return mValue != nullptr; }
+
+    private:
+        friend class SharedSnapshot;
+        ReadGuard ( const SharedSnapshot* owner, int slot, const T* value ) : mOwner ( owner ), mSlot ( slot ), mValue ( value ) { }
+
+        const SharedSnapshot* mOwner;
+        int mSlot;
+        const T* mValue;
+    };
+
+    SharedSnapshot ( ) : mCurrent ( nullptr ), mEpoch ( 1 )
+    {
+        for ( auto& epoch : mReaderEpochs ) { epoch.store ( 0, std::memory_order_relaxed ); }
+    }
+
+    ~SharedSnapshot ( )
+    {
+        delete mCurrent.load ( std::memory_order_acquire );
+    }
+
+    SharedSnapshot ( const SharedSnapshot& ) = delete;
+    SharedSnapshot& operator= ( const SharedSnapshot& ) = delete;
+
+    // readers ------------------------------------
+
+    ReadGuard Read ( ) const
+    {
+        uint64_t epoch = mEpoch.load ( std::memory_order_seq_cst );
+
+        // claim any idle slot, only fails if more than kMaxReaders reads overlap
+        for ( int slot = 0; slot < kMaxReaders; slot++ )
+        {
+            uint64_t idle = 0;
+            if ( mReaderEpochs[slot].compare_exchange_strong ( idle, epoch, std::memory_order_seq_cst ) )
+            {
+                return ReadGuard ( this, slot, mCurrent.load ( std::memory_order_seq_cst ) );
+            }
+        }
+
+        return ReadGuard ( this, -1, nullptr );
+    }
+
+    // writers ------------------------------------
+
+    void Publish ( std::unique_ptr<T> value )
+    {
+        std::lock_guard<std::mutex> lock ( mWriterMutex );
+
+        T* previous = mCurrent.exchange ( value.release ( ), std::memory_order_seq_cst );
+        uint64_t retireEpoch = mEpoch.fetch_add ( 1, std::memory_order_seq_cst ) + 1;
+        if ( previous != nullptr ) { mRetired.push_back ( { std::unique_ptr<T> ( previous ), retireEpoch } ); }
+
+        ReclaimLocked ( );
+    }
+
+    void Reclaim ( ) // frees replaced snapshots that are no longer being read, call regularly from a writer thread
+    {
+        std::lock_guard<std::mutex> lock ( mWriterMutex );
+        ReclaimLocked ( );
+    }
+
+private:
+    static constexpr int kMaxReaders = 32;
+
+    struct Retired {
+        std::unique_ptr<T> value;
+        uint64_t epoch; // readers that started at or after this epoch can only have seen a newer snapshot
+    };
+
+    void ReclaimLocked ( )
+    {
+        if ( mRetired.empty ( ) ) { return; }
+
+        uint64_t oldestReader = UINT64_MAX;
+        for ( const auto& epoch : mReaderEpochs )
+        {
+            uint64_t readerEpoch = epoch.load ( std::memory_order_seq_cst );
+            if ( readerEpoch != 0 && readerEpoch < oldestReader ) { oldestReader = readerEpoch; }
+        }
+
+        size_t kept = 0;
+        for ( size_t i = 0; i < mRetired.size ( ); i++ )
+        {
+            if ( mRetired[i].epoch <= oldestReader ) { continue; } // unique_ptr frees it when the vector shrinks
+            std::swap ( mRetired[kept++], mRetired[i] );
+        }
+        mRetired.resize ( kept );
+    }
+
+    std::atomic<T*> mCurrent;
+    std::atomic<uint64_t> mEpoch;
+    mutable std::atomic<uint64_t> mReaderEpochs[kMaxReaders]; // 0 when idle, otherwise the epoch the read started in
+
+    std::mutex mWriterMutex;
+    std::vector<Retired> mRetired;
+};
+
+} // namespace Utilities
+} // namespace Acorex
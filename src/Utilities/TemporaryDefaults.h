@@ -12,6 +12,8 @@
 
 //default explorer settings values (could have both default globals an per-corpus "last used")
 #define DEFAULT_CONTROL_RECEIVER_INDEX 0
+#define DEFAULT_TELEMETRY_OSC_PORT 13020 // audio thread telemetry is sent to localhost on this port plus the control receiver index
+#define DEFAULT_TELEMETRY_OSC_INTERVAL_MS 500
 
 #define DEFAULT_DIMENSION_X "None" // these could be set by name in per-corpus settings
 #define DEFAULT_DIMENSION_Y "None"
@@ -24,8 +26,12 @@
 #define DEFAULT_JUMP_SAME_FILE_MIN_DIFF 2
 #define DEFAULT_CROSSOVER_JUMP_CHANCE_X1000 950 // out of 1000
 #define DEFAULT_CROSSFADE_SAMPLE_LENGTH 16384
+#define DEFAULT_KILL_FADE_SAMPLE_LENGTH 1024 // a killed or ended playhead always fades out over this long, carrying into the next buffers if needed
 #define DEFAULT_MAX_JUMP_DISTANCE_SPACE_X1000 50 // out of 1000
 #define DEFAULT_MAX_JUMP_TARGETS 5
+#define DEFAULT_SELECTION_CLICK_RADIUS_X1000 30 // out of 1000, a shift click selects the points this near the picked point
+#define DEFAULT_SELECTION_CLICK_MAX_POINTS 65536
+#define DEFAULT_JUMP_ALL_DIMENSIONS false // jump by similarity across every analysed dimension, not just the displayed ones
 #define DEFAULT_VOLUME_X1000 500 // out of 1000
 #define DEFAULT_PANNING_STRENGTH_X1000 1000 // out of 1000
 
@@ -42,6 +48,49 @@
 #define DEFAULT_OUT_DEVICE_INDEX 0
 #define DEFAULT_BUFFER_SIZE 512
 
+// explorer corpus audio storage - compile time only, there are no menu settings for these yet
+#define DEFAULT_AUDIO_STORAGE_MODE 0 // 0 = resident (decode every file when opening a corpus), 1 = streamed from disk during playback, 2 = cached on demand
+#define DEFAULT_STREAM_MAX_PLAYHEADS 32 // each streamed playhead uses two stream slots
+#define DEFAULT_STREAM_RING_FRAMES 65536 // per stream slot, must be a power of two
+#define DEFAULT_STREAM_DECODE_CHUNK_FRAMES 4096
+#define DEFAULT_AUDIO_COMPACT_SAMPLES false // hold resident corpus audio as int16 instead of float, halving its memory
+#define DEFAULT_AUDIO_DEVICE_SAMPLE_RATE 0 // 0 runs the device at the corpus rate if it supports it, or converts to one it does, otherwise always converts to this
+#define DEFAULT_AUDIO_CACHE_BUDGET_MB 2048
+#define DEFAULT_AUDIO_CACHE_JUMP_REQUESTS_MISSING true // jumps only land in cached files, but a nearer uncached candidate is loaded for later
+
+// explorer jump planning
+#define DEFAULT_JUMP_PLANNER_QUEUE_SIZE 16 // per playhead, must be a power of two
+#define DEFAULT_JUMP_PLANNER_LOOKAHEAD 2 // trigger points planned ahead of each playhead
+
+// explorer playheads
+#define DEFAULT_MAX_PLAYHEADS 128 // the voice pool, allocated when the audio stream starts
+#define DEFAULT_CHECK_AUDIO_THREAD_ALLOCATIONS false // debug builds only, asserts if the audio callback allocates or frees memory
+#define DEFAULT_VOICE_RENDER_WORKERS 0 // threads rendering playheads alongside the audio thread, one core each, 0 renders them all on the audio thread
+#define DEFAULT_VOICE_RENDER_MIN_PARALLEL_PLAYHEADS 16 // fewer playheads than this are rendered on the audio thread alone, handing them out would cost more than it saves
+
+// realtime worker pools
+#define DEFAULT_REALTIME_WORKER_SPINS 4000 // busy waits for the next batch before starting to yield
+#define DEFAULT_REALTIME_WORKER_PARK_AFTER_MS 50 // idle time before a worker sleeps until woken, longer than any audio buffer
+
+// explorer playhead commands, from control threads to the audio thread
+#define DEFAULT_PLAYHEAD_COMMAND_QUEUE_SIZE 64 // must be a power of two
+#define DEFAULT_PLAYHEAD_COMMAND_RESERVE 16 // new playheads are refused once only this many places are left, so kills and parameter changes always fit
+
+// explorer offline rendering
+#define DEFAULT_OFFLINE_RENDER_BUFFER_SIZE 512 // also capped at the corpus hop size, so every jump a buffer takes was planned before it started
+#define DEFAULT_OFFLINE_RENDER_SOURCE_TIMEOUT_MS 5000 // longest a buffer waits on streamed or cached audio before rendering without it
+
+// explorer quality governor, trades playback detail for headroom when callbacks come close to their deadline
+#define DEFAULT_GOVERNOR_ENABLED true
+#define DEFAULT_GOVERNOR_DEGRADE_ABOVE_PERCENT 80 // callback load, as a percentage of the time its buffer lasts
+#define DEFAULT_GOVERNOR_RECOVER_BELOW_PERCENT 50
+#define DEFAULT_GOVERNOR_STEP_INTERVAL_MS 250 // least audio time between steps down, so each step is measured before the next
+#define DEFAULT_GOVERNOR_RECOVER_AFTER_MS 2000 // audio time load must stay under the recover threshold for each step back up
+#define DEFAULT_GOVERNOR_CROSSFADE_SAMPLE_LENGTH 2048 // longest crossfade once degraded
+#define DEFAULT_GOVERNOR_JUMP_CHANCE_PERCENT 25 // of the crossover jump chance once degraded further, each jump is a crossfade mixing two sources
+#define DEFAULT_GOVERNOR_VISUAL_UPDATE_DIVISOR 4 // visual playheads updated every this many buffers once degraded
+#define DEFAULT_GOVERNOR_SHED_VOICES 4 // oldest playheads faded out at each step while still over at the last level
+
 
 // default analysis settings - store globally (xml?)
 // already kind of exists in Data.h in struct AnalysisSettings
@@ -28,6 +28,8 @@
 
 #define ACOREX_KEYBIND_AUDIO_PAUSE          ' '
 
+#define ACOREX_KEYBIND_RENDER_OFFLINE OF_KEY_F11
+
 #define ACOREX_KEYBIND_TOGGLE_MOUSE_CAMERA_CONTROL 'c'
 
 //PointPicker key binds
@@ -52,5 +54,8 @@
 
 #define ACOREX_KEYBIND_SET_THIS_INSTANCE_MIDI_HUB OF_KEY_F8
 
+#define ACOREX_KEYBIND_BENCHMARK_RESAMPLER OF_KEY_F9
+#define ACOREX_KEYBIND_BENCHMARK_MIXING OF_KEY_F10
+
 // Mouse Bind Reference:
 // PointPicker - OF_MOUSE_BUTTON_RIGHT, MouseReleased - select point
\ No newline at end of file
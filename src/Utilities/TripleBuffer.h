@@ -0,0 +1,71 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026-2026 Elowyn Fearne
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Acorex {
+namespace Utilities {
+
+// hands the latest value from exactly one producer thread to exactly one consumer thread, wait-free on both sides
+// the producer writes into its own buffer and swaps it with the spare, the consumer swaps the spare for its own when something newer is there
+// neither side ever waits on or allocates for the other, values the consumer was too slow to take are simply skipped
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer ( ) : mWriteIndex ( 0 ), mSpare ( 1 ), mReadIndex ( 2 ) { }
+
+    TripleBuffer ( const TripleBuffer& ) = delete;
+    TripleBuffer& operator= ( const TripleBuffer& ) = delete;
+
+    // producer only ------------------------------
+
+    T& Write ( ) { return mBuffers[mWriteIndex]; } // holds whatever was there before, not the last value published
+    void Publish ( )
+    {
+        uint8_t previous = mSpare.exchange ( mWriteIndex | kFresh, std::memory_order_acq_rel );
+        mWriteIndex = previous & kIndexMask;
+    }
+
+    // consumer only ------------------------------
+
+    // true if a newer value was taken, either way Read then returns the newest the consumer has
+    bool Update ( )
+    {
+        if ( ( mSpare.load ( std::memory_order_relaxed ) & kFresh ) == 0 ) { return false; }
+
+        uint8_t previous = mSpare.exchange ( mReadIndex, std::memory_order_acq_rel );
+        mReadIndex = previous & kIndexMask;
+        return true;
+    }
+    const T& Read ( ) const { return mBuffers[mReadIndex]; }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFresh = 0x4; // set on the spare when the producer has published into it
+
+    T mBuffers[3];
+
+    alignas ( 64 ) uint8_t mWriteIndex; // producer only
+    alignas ( 64 ) std::atomic<uint8_t> mSpare; // index of the buffer neither side holds, plus kFresh
+    alignas ( 64 ) uint8_t mReadIndex; // consumer only
+};
+
+} // namespace Utilities
+} // namespace Acorex
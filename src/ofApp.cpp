@@ -18,6 +18,8 @@ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 
 #include "Utilities/TemporaryDefaults.h"
 #include "Utilities/TemporaryKeybinds.h"
+#include "Utilities/Resampler.h"
+#include "Utilities/MixKernels.h"
 
 #define ACOREX_VERSION_STRING "v1.1.0-dev.build.2026.02.18.b"
 
@@ -200,6 +202,16 @@ void ofApp::KeyEvent ( ofKeyEventArgs& args )
             InitialiseMidiHub ( );
             ofLogNotice ( "MIDI-HUB" ) << "This instance is now a MIDI hub.";
         }
+        else if ( args.key == ACOREX_KEYBIND_BENCHMARK_RESAMPLER )
+        {
+            ofLogNotice ( "Resampler" ) << "Benchmarking resampling...";
+            Acorex::Utilities::Resampler::Benchmark ( );
+        }
+        else if ( args.key == ACOREX_KEYBIND_BENCHMARK_MIXING )
+        {
+            ofLogNotice ( "MixKernels" ) << "Benchmarking mixing...";
+            Acorex::Utilities::MixKernels::Benchmark ( );
+        }
     }
 }
 